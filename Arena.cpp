@@ -0,0 +1,46 @@
+// File: Arena.cpp
+// Date: 10/18/26
+// Implementation of the Arena class
+
+#include "Arena.hpp"
+
+Arena::Arena(std::size_t block_bytes) :
+    blocks_(nullptr),
+    cursor_(nullptr),
+    limit_(nullptr),
+    block_bytes_(block_bytes),
+    reserved_(0) {
+}
+
+Arena::~Arena() {
+    release();
+}
+
+void* Arena::allocateSlow(std::size_t bytes, std::size_t alignment) {
+    std::size_t usable = bytes + alignment;
+    if (usable < block_bytes_) {
+        usable = block_bytes_;
+    }
+
+    // The block header is followed directly by its usable bytes
+    Block* block = static_cast<Block*>(::operator new(sizeof(Block) + usable));
+    block->next = blocks_;
+    block->bytes = usable;
+    blocks_ = block;
+    reserved_ += usable;
+
+    cursor_ = reinterpret_cast<char*>(block + 1);
+    limit_ = cursor_ + usable;
+    return allocate(bytes, alignment);
+}
+
+void Arena::release() {
+    while (blocks_ != nullptr) {
+        Block* next = blocks_->next;
+        ::operator delete(blocks_);
+        blocks_ = next;
+    }
+    cursor_ = nullptr;
+    limit_ = nullptr;
+    reserved_ = 0;
+}
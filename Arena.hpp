@@ -0,0 +1,87 @@
+// File: Arena.hpp
+// Date: 10/18/26
+// A bump allocator whose memory is all freed at once, for state that lives exactly
+// as long as one game
+
+#ifndef ARENA_HPP_
+#define ARENA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+/**
+ * @brief Hands out memory from large blocks by bumping a pointer. Nothing is freed
+ *      individually: release() (or the destructor) returns every block in one shot, so only
+ *      trivially destructible objects may live in an arena.
+ */
+class Arena {
+    private:
+        struct Block {
+            Block* next;        // Previously filled block
+            std::size_t bytes;  // Usable bytes after this header
+        };
+
+        Block* blocks_;             // Most recent block first
+        char* cursor_;              // Next free byte in the current block
+        char* limit_;               // End of the current block
+        std::size_t block_bytes_;   // Usable bytes of a regular block
+        std::size_t reserved_;      // Total usable bytes of all blocks
+
+        // Starts a new block big enough for the request and allocates from it
+        void* allocateSlow(std::size_t bytes, std::size_t alignment);
+
+    public:
+        /**
+         * @brief Parameterized constructor. No memory is taken until the first allocation.
+         * @param block_bytes Usable bytes per block. Larger requests get a block of their own.
+         */
+        explicit Arena(std::size_t block_bytes = 4096);
+
+        /**
+         * @brief Destructor: releases every block
+         */
+        ~Arena();
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        /**
+         * @brief Allocates uninitialized memory
+         * @param alignment A power of two
+         */
+        void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+            std::uintptr_t aligned = (reinterpret_cast<std::uintptr_t>(cursor_) + alignment - 1) & ~(alignment - 1);
+            if (cursor_ != nullptr && aligned + bytes <= reinterpret_cast<std::uintptr_t>(limit_)) {
+                cursor_ = reinterpret_cast<char*>(aligned + bytes);
+                return reinterpret_cast<void*>(aligned);
+            }
+            return allocateSlow(bytes, alignment);
+        }
+
+        /**
+         * @brief Allocates an array of default-constructed T
+         */
+        template <typename T>
+        T* allocateArray(std::size_t count) {
+            static_assert(std::is_trivially_destructible<T>::value, "Arena never runs destructors");
+            T* items = static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+            for (std::size_t i = 0; i < count; i++) {
+                new (items + i) T();
+            }
+            return items;
+        }
+
+        /**
+         * @brief Frees every block. Everything allocated from the arena becomes invalid.
+         */
+        void release();
+
+        /**
+         * @return Usable bytes held in blocks (allocated or not)
+         */
+        std::size_t bytesReserved() const { return reserved_; }
+};
+
+#endif
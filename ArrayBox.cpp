@@ -2,22 +2,56 @@
 #define ARRAY_BOX_CPP_
 
 #include "ArrayBox.hpp"
+#include <cstring>
+#include <new>
 
+// Allocates room for `capacity` objects without constructing any of them
 template <typename T>
-ArrayBox<T>::ArrayBox() : capacity_(64), size_(0) {
-    items_ = new T[capacity_];
+static T* allocateSpaces(int capacity) {
+    return static_cast<T*>(::operator new(sizeof(T) * capacity));
 }
 
 template <typename T>
-ArrayBox<T>::ArrayBox(const int& capacity) : size_(0) {
+int slotIndexOf(const T* items, const std::string& type, int start, int end) {
+    for (int i = start; i < end; i++) {
+        if (items[i].getType() == type) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+template <typename T>
+int slotCount(const T* items, const std::string& type, int end) {
+    int count = 0;
+    int pos = 0;
+    while (pos < end) {
+        if (items[pos].getType() == type) {
+            count++;
+            // At least one space, so a damaged item of size 0 cannot stall the walk
+            pos += items[pos].size() > 0 ? items[pos].size() : 1;
+        } else {
+            pos++;
+        }
+    }
+    return count;
+}
+
+template <typename T>
+ArrayBox<T>::ArrayBox() : capacity_(64), size_(0), end_(0), growable_(false), reuse_gaps_(false), compact_threshold_(0) {
+    items_ = allocateSpaces<T>(capacity_);
+}
+
+template <typename T>
+ArrayBox<T>::ArrayBox(const int& capacity) : size_(0), end_(0), growable_(false), reuse_gaps_(false), compact_threshold_(0) {
     // Use 64 if capacity is not positive
     if (capacity <= 0) {
         capacity_ = 64;
     } else {
         capacity_ = capacity;
     }
-    
-    items_ = new T[capacity_];
+
+    items_ = allocateSpaces<T>(capacity_);
 }
 
 template <typename T>
@@ -30,98 +64,339 @@ int ArrayBox<T>::capacity() const {
     return capacity_;
 }
 
+template <typename T>
+int ArrayBox<T>::gapSpace() const {
+    return end_ - size_;
+}
+
+template <typename T>
+void ArrayBox<T>::relocate(T* dst, T* src, int count) {
+    if (dst == src || count <= 0) {
+        return;
+    }
+    if (std::is_trivially_copyable<T>::value) {
+        std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(T) * count);
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        new (dst + i) T(std::move(src[i]));
+        src[i].~T();
+    }
+}
+
+template <typename T>
+void ArrayBox<T>::destroyItems() {
+    if (std::is_trivially_destructible<T>::value) {
+        return;
+    }
+    int pos = 0;
+    while (pos < end_) {
+        int next = nextBoundary(pos);
+        if (!isGapStart(pos)) {
+            for (int i = pos; i < next; i++) {
+                items_[i].~T();
+            }
+        }
+        pos = next;
+    }
+}
+
+template <typename T>
+void ArrayBox<T>::reallocate(int new_capacity) {
+    T* fresh = allocateSpaces<T>(new_capacity);
+
+    // Move each item run across, leaving the gaps behind
+    int write = 0;
+    int pos = 0;
+    while (pos < end_) {
+        int next = nextBoundary(pos);
+        if (!isGapStart(pos)) {
+            relocate(fresh + write, items_ + pos, next - pos);
+            write += next - pos;
+        }
+        pos = next;
+    }
+
+    ::operator delete(items_);
+    items_ = fresh;
+    capacity_ = new_capacity;
+    end_ = write;
+
+    if (reuse_gaps_) {
+        gap_.assign(capacity_, 0);
+        free_spans_.clear();
+    }
+}
+
+template <typename T>
+void ArrayBox<T>::setGrowable(bool growable) {
+    growable_ = growable;
+}
+
+template <typename T>
+void ArrayBox<T>::reserve(int capacity) {
+    if (capacity > capacity_) {
+        reallocate(capacity);
+    }
+}
+
+template <typename T>
+void ArrayBox<T>::shrink_to_fit() {
+    int target = (size_ > 0) ? size_ : 1;
+    if (target != capacity_) {
+        reallocate(target);
+    } else {
+        compact();
+    }
+}
+
+template <typename T>
+bool ArrayBox<T>::isGapStart(int pos) const {
+    return reuse_gaps_ && gap_[pos] > 0;
+}
+
+template <typename T>
+int ArrayBox<T>::nextBoundary(int pos) const {
+    if (isGapStart(pos)) {
+        return pos + gap_[pos];
+    }
+    // Guard against zero-sized items so the walk always advances
+    int item_size = items_[pos].size();
+    return pos + (item_size > 0 ? item_size : 1);
+}
+
 template <typename T>
 int ArrayBox<T>::getIndexOf(const std::string& type, int start, int end) const {
     // Check if the parameters are valid
-    if (start < 0 || start >= size_ || end < 0 || end > size_ || start >= end) {
+    if (start < 0 || start >= end_ || end < 0 || end > end_ || start >= end) {
         return -1;
     }
-    
+
     // Search for the item
-    for (int i = start; i < end; i++) {
-        if (items_[i].getType() == type) {
-            return i;
+    if (!reuse_gaps_) {
+        return slotIndexOf(items_, type, start, end);
+    }
+
+    // With gaps present, walk item by item so gap contents are never matched
+    for (int pos = 0; pos < end; pos = nextBoundary(pos)) {
+        if (pos >= start && !isGapStart(pos) && items_[pos].getType() == type) {
+            return pos;
         }
     }
-    
+
     // Item not found
     return -1;
 }
 
+template <typename T>
+void ArrayBox<T>::tagGap(int start, int length) {
+    gap_[start + length - 1] = -length;
+    gap_[start] = length;
+}
+
+template <typename T>
+void ArrayBox<T>::takeGap(int start, int length) {
+    free_spans_.erase(std::make_pair(length, start));
+    gap_[start] = 0;
+    gap_[start + length - 1] = 0;
+}
+
+template <typename T>
+void ArrayBox<T>::releaseSpan(int start, int length) {
+    // Merge with a gap directly to the right
+    int right = start + length;
+    if (right < end_ && isGapStart(right)) {
+        int right_length = gap_[right];
+        takeGap(right, right_length);
+        length += right_length;
+    }
+
+    // Merge with a gap directly to the left, found through its end tag
+    // (a one-space gap only has its positive start tag)
+    if (start > 0 && gap_[start - 1] != 0) {
+        int left_length = (gap_[start - 1] < 0) ? -gap_[start - 1] : 1;
+        int left = start - left_length;
+        takeGap(left, left_length);
+        start = left;
+        length += left_length;
+    }
+
+    // A gap at the tail is just unused space
+    if (start + length == end_) {
+        end_ = start;
+        return;
+    }
+
+    tagGap(start, length);
+    free_spans_.insert(std::make_pair(length, start));
+}
+
+template <typename T>
+void ArrayBox<T>::setGapReuse(bool enabled, int compact_threshold) {
+    if (!enabled) {
+        compact();
+        reuse_gaps_ = false;
+        gap_.clear();
+        compact_threshold_ = 0;
+        return;
+    }
+
+    if (!reuse_gaps_) {
+        gap_.assign(capacity_, 0);
+        reuse_gaps_ = true;
+    }
+    compact_threshold_ = (compact_threshold < 0) ? 0 : compact_threshold;
+}
+
+template <typename T>
+void ArrayBox<T>::compact() {
+    if (end_ == size_) {
+        return;
+    }
+
+    // Slide every item left over the gaps, keeping their relative order.
+    // Everything in [write, pos) is unconstructed, so items are relocated into it.
+    int write = 0;
+    int pos = 0;
+    while (pos < end_) {
+        int next = nextBoundary(pos);
+        if (!isGapStart(pos)) {
+            relocate(items_ + write, items_ + pos, next - pos);
+            write += next - pos;
+        }
+        pos = next;
+    }
+
+    // Clear the gap bookkeeping
+    for (int i = 0; i < end_; i++) {
+        gap_[i] = 0;
+    }
+    free_spans_.clear();
+    end_ = write;
+}
+
 template <typename T>
 bool ArrayBox<T>::addItem(const T& item) {
     int item_size = item.size();
-    
-    // Check if there's enough space
+
+    // Check if there's enough space, growing first if allowed
     if (size_ + item_size > capacity_) {
-        return false;
+        if (!growable_) {
+            return false;
+        }
+        int doubled = capacity_ * 2;
+        reallocate(doubled > size_ + item_size ? doubled : size_ + item_size);
+    }
+
+    int start = end_;
+    if (reuse_gaps_ && item_size > 0) {
+        // Best fit: the smallest gap that can hold the item
+        auto fit = free_spans_.lower_bound(std::make_pair(item_size, -1));
+        if (fit != free_spans_.end()) {
+            int gap_length = fit->first;
+            start = fit->second;
+            takeGap(start, gap_length);
+
+            // Whatever the item does not use stays a (smaller) gap
+            if (gap_length > item_size) {
+                int rest = start + item_size;
+                int rest_length = gap_length - item_size;
+                tagGap(rest, rest_length);
+                free_spans_.insert(std::make_pair(rest_length, rest));
+            }
+        } else if (end_ + item_size > capacity_) {
+            // Enough total space, but it is fragmented
+            compact();
+            start = end_;
+        }
     }
-    
-    // Add the item to the leftmost non-occupied space
+
+    // Construct the item in the chosen (leftmost non-occupied, without gap reuse) spaces
     for (int i = 0; i < item_size; i++) {
-        items_[size_ + i] = item;
+        new (items_ + start + i) T(item);
     }
-    
+
     // Update size
     size_ += item_size;
-    
+    if (start == end_) {
+        end_ += item_size;
+    }
+
     return true;
 }
 
 template <typename T>
 bool ArrayBox<T>::remove(const std::string& type) {
     // Find the first instance of the item
-    int index = getIndexOf(type, 0, size_);
-    
+    int index = getIndexOf(type, 0, end_);
+
     // If not found, return false
     if (index == -1) {
         return false;
     }
-    
+
     // Get the size of the item to remove
     int item_size = items_[index].size();
-    
-    // Shift elements over by the size of the removed item
-    for (int i = index; i + item_size < size_; i++) {
-        items_[i] = items_[i + item_size];
+
+    if (reuse_gaps_) {
+        // Leave the span as a gap rather than shifting everything after it
+        for (int i = index; i < index + item_size; i++) {
+            items_[i].~T();
+        }
+        size_ -= item_size;
+        releaseSpan(index, item_size);
+
+        if (compact_threshold_ > 0 && gapSpace() >= compact_threshold_) {
+            compact();
+        }
+        return true;
     }
-    
-    // Set the now unused spaces to default-initialized objects
-    for (int i = size_ - item_size; i < size_; i++) {
-        items_[i] = T();
+
+    // Destroy the removed item, then shift elements over by its size
+    for (int i = index; i < index + item_size; i++) {
+        items_[i].~T();
     }
-    
+    relocate(items_ + index, items_ + index + item_size, size_ - index - item_size);
+
     // Update size
     size_ -= item_size;
-    
+    end_ = size_;
+
     return true;
 }
 
 template <typename T>
 int ArrayBox<T>::count(const std::string& type) const {
+    if (!reuse_gaps_) {
+        return slotCount(items_, type, end_);
+    }
+
     int count = 0;
     int pos = 0;
-    
-    while (pos < size_) {
-        if (items_[pos].getType() == type) {
+
+    while (pos < end_) {
+        if (isGapStart(pos)) {
+            pos += gap_[pos];
+        } else if (items_[pos].getType() == type) {
             count++;
             pos += items_[pos].size();
         } else {
             pos++;
         }
     }
-    
+
     return count;
 }
 
 template <typename T>
 bool ArrayBox<T>::contains(const std::string& type) const {
-    return getIndexOf(type, 0, size_) != -1;
+    return getIndexOf(type, 0, end_) != -1;
 }
 
 template <typename T>
 ArrayBox<T>::~ArrayBox() {
-    delete[] items_;
+    destroyItems();
+    ::operator delete(items_);
 }
 
-#endif // ARRAY_BOX_CPP_
\ No newline at end of file
+#endif // ARRAY_BOX_CPP_
@@ -2,15 +2,85 @@
 #define ARRAY_BOX_HPP_
 
 #include <string>
+#include <set>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief The space layout shared by ArrayBox and MappedArrayBox: an item of size() n takes up
+ *      n consecutive spaces, each holding a copy of it, so items start at 0, n0, n0 + n1, ...
+ *      These walk a run of occupied spaces with no gaps in it.
+ */
+
+// Leftmost space in [start, end) whose item has the given type, or -1
+template <typename T>
+int slotIndexOf(const T* items, const std::string& type, int start, int end);
+
+// Number of items of the given type in spaces [0, end), each item counted once
+template <typename T>
+int slotCount(const T* items, const std::string& type, int end);
 
 template <typename T>
 class ArrayBox {
     private:
         int capacity_;  // Maximum capacity of the array
         int size_;      // Current occupied spaces in the array
+        int end_;       // One past the last occupied space. Equals size_ unless gaps are reused
+
+        bool growable_;             // True when a full box reallocates instead of rejecting the add
+        bool reuse_gaps_;           // True when removals leave gaps instead of shifting
+        int compact_threshold_;     // Gap spaces that trigger an automatic compact(), 0 to disable
+        std::vector<int> gap_;      // Boundary tags: +length at the first space of a gap, -length at its last, 0 elsewhere
+        std::set<std::pair<int, int>> free_spans_;  // Free gaps as (length, start), ordered by size for best-fit
+
+        /**
+         * @brief Records [start, start + length) as a gap, merging it with adjacent gaps.
+         *      A gap that ends at end_ is dropped and end_ is pulled back instead.
+         */
+        void releaseSpan(int start, int length);
+
+        /**
+         * @brief Writes the boundary tags for a gap of the given length starting at `start`
+         */
+        void tagGap(int start, int length);
+
+        /**
+         * @brief Removes the gap starting at `start` with the given length from the free list and tags
+         */
+        void takeGap(int start, int length);
+
+        /**
+         * @return The index of the next item (or gap) boundary after the boundary at `pos`
+         */
+        int nextBoundary(int pos) const;
+
+        /**
+         * @return True if `pos` is the first space of a gap
+         */
+        bool isGapStart(int pos) const;
     
+        /**
+         * @brief Moves `count` constructed objects from src to the unconstructed
+         *      spaces at dst (memmove for trivially copyable T), destroying the sources.
+         *      The ranges may overlap as long as dst <= src.
+         */
+        static void relocate(T* dst, T* src, int count);
+
+        /**
+         * @brief Destroys every constructed object in [0, end_), skipping gaps
+         */
+        void destroyItems();
+
+        /**
+         * @brief Moves the items into a fresh buffer of `new_capacity` spaces.
+         *      Gaps are squeezed out on the way, as by compact().
+         * @pre new_capacity >= size_
+         */
+        void reallocate(int new_capacity);
+
     protected:
-        T* items_;      // Dynamic array to hold elements
+        T* items_;      // Uninitialized storage. Only spaces covered by an item hold constructed objects
 
         /**
          *  @brief Searches a subarray of `items_` for an item of the given type. 
@@ -30,6 +100,8 @@ class ArrayBox {
          *  b) If `end` is negative or > size_
          *  c) If `start` >= `end`
             The search is fails to execute, and -1 is returned.
+         *  In gap-reuse mode the bounds are checked against end_ instead of size_,
+         *  gaps are skipped, and the returned index is always the start of an item.
         **/
         int getIndexOf(const std::string& type, int start, int end) const;
 
@@ -37,7 +109,8 @@ class ArrayBox {
         /**
         * @brief Default constructor
         * @post Initializes capacity_ to 64 and size_ to 0. 
-        *      Allocates a dynamic array for items_ of length equal to the capacity_. 
+        *      Allocates uninitialized storage for items_ of length equal to the capacity_.
+        *      No element is constructed until an item is added.
         */
         ArrayBox();
 
@@ -45,10 +118,14 @@ class ArrayBox {
         * @brief Parameterized constructor
         * @param capacity A const reference to an integer describing the maximum capacity of the items_ array.
         *      If capacity is not positive (ie. <= 0), 64 is used instead.
-        * @post size_ is initialized to 0. items_ is initialized to a dynamically allocated array of length equal to 'capacity'
+        * @post size_ is initialized to 0. items_ is initialized to uninitialized storage of length equal to 'capacity'
         */
         ArrayBox(const int& capacity);
 
+        // The box owns raw storage, so copies are not supported
+        ArrayBox(const ArrayBox& other) = delete;
+        ArrayBox& operator=(const ArrayBox& other) = delete;
+
         /**
         * Getter for the size member
         * @return Returns the integer value stored in size_
@@ -61,6 +138,51 @@ class ArrayBox {
         */
         int capacity() const;
 
+        /**
+         * @brief Opts in to (or out of) growth. A growable box that runs out of space
+         *      reallocates to twice its capacity (or more, if the item needs it) instead
+         *      of rejecting the add. Items are moved into the new buffer, never copied.
+         * @param growable True to let addItem() grow capacity_
+         */
+        void setGrowable(bool growable);
+
+        /**
+         * @brief Grows capacity_ to at least `capacity` spaces. Works in either growth mode.
+         * @param capacity The minimum capacity to ensure. Smaller values do nothing.
+         */
+        void reserve(int capacity);
+
+        /**
+         * @brief Compacts the items and reallocates so that capacity_ equals size_
+         *      (or 1 for an empty box, since the capacity must stay positive).
+         */
+        void shrink_to_fit();
+
+        /**
+         * @brief Switches between the default shift-on-remove mode and gap-reuse mode.
+         *      In gap-reuse mode remove() leaves the removed span as a gap on a size-ordered
+         *      free list and addItem() places items into the best-fitting gap (the smallest
+         *      one that is large enough) before appending at the end.
+         *
+         * @param enabled True to enable gap reuse. Disabling it compacts the array first.
+         * @param compact_threshold Once the total gap space reaches this many spaces, remove()
+         *      compacts automatically. 0 (the default) only compacts on an explicit compact()
+         *      or when an add cannot otherwise fit.
+         * @post size() and capacity() are unaffected.
+         */
+        void setGapReuse(bool enabled, int compact_threshold = 0);
+
+        /**
+         * @brief Slides every item left over the gaps, preserving their order,
+         *      so that the occupied spaces are exactly [0, size_) again.
+         */
+        void compact();
+
+        /**
+         * @return The number of spaces currently lost to gaps (always 0 outside gap-reuse mode)
+         */
+        int gapSpace() const;
+
         /**
          * @brief Appends the parameter item to the `items_` array such that:
          *  1) There current size_ and target.size() is small enough 
@@ -70,6 +192,9 @@ class ArrayBox {
          * 
          * @param type A const reference to an item of type T, specifying the object to add
          * @return True if the add was successful. False otherwise.
+         * @note In gap-reuse mode the item goes into the best-fitting gap if there is one.
+         *      If only the combined gap space is large enough, the array is compacted first.
+         * @note A growable box grows instead of failing when the item does not fit.
          * @post Increment size_ if the item was added.
          */
         bool addItem(const T& item);
@@ -81,14 +206,15 @@ class ArrayBox {
         *      
         *      `size_` is also decremented by the size of the object we just removed.
         * 
-        *      Instead of lazy-deletion, all values that are not counted as part of the valid subarray, ie. not from indices [0, size_)
-        *      are set to a default-initialized object
+        *      Instead of lazy-deletion, the spaces that fall out of the valid subarray, ie. not from indices [0, size_)
+        *      are destroyed and left as uninitialized storage
         * 
         *      If no object of the given type is found, nothing happens.
         *  
         * @param type A const reference to a string specifying the type of the object to remove
         *
         * @post Objects after the removed instance are shifted elements over by the size of the object we just removed
+        * @note In gap-reuse mode nothing is shifted: the removed span becomes a gap instead (see setGapReuse)
         * 
         * @return True if the remove operation was successfully performed. False otherwise.
         */
@@ -112,6 +238,12 @@ class ArrayBox {
          */
         bool contains(const std::string& type) const;
 
+        /**
+         * @return The item occupying space `index`, for random access
+         * @pre 0 <= index < size(), and outside gap-reuse mode (or compacted) so no gap is there
+         */
+        const T& at(int index) const { return items_[index]; }
+
         // Destructor
         ~ArrayBox();
 };
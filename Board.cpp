@@ -0,0 +1,151 @@
+// File: Board.cpp
+// Date: 10/18/26
+// Implementation of the Board class
+
+#include "Board.hpp"
+#include <algorithm>
+
+Board::Board() : side_to_move_(WHITE_PLAYER), score_(0), pawn_key_(0) {
+}
+
+void Board::clear() {
+    // Copied as a block: PackedPiece() is not all zero bytes, so a loop of assignments stores field by field
+    static const Board EMPTY;
+    std::copy(EMPTY.squares_, EMPTY.squares_ + SQUARES, squares_);
+    side_to_move_ = WHITE_PLAYER;
+    score_ = 0;
+    pawn_key_ = 0;
+}
+
+void Board::rescore() {
+    score_ = 0;
+    pawn_key_ = 0;
+    for (int square = 0; square < SQUARES; square++) {
+        if (squares_[square].type() != PieceType::None) {
+            score_ += squareScore(squares_[square], square);
+            pawn_key_ ^= pawnSquareKey(squares_[square], square);
+        }
+    }
+}
+
+PackedPiece Board::pieceAt(int row, int col) const {
+    if (row < 0 || row >= BOARD_LENGTH || col < 0 || col >= BOARD_LENGTH) {
+        return PackedPiece();
+    }
+    return squares_[row * BOARD_LENGTH + col];
+}
+
+int Board::count(PieceType type, int player) const {
+    int count = 0;
+    for (int square = 0; square < SQUARES; square++) {
+        if (squares_[square].type() == type && squares_[square].getColor() == player) {
+            count++;
+        }
+    }
+    return count;
+}
+
+bool Board::isPseudoLegal(const Move& move) const {
+    if (move.from >= SQUARES || move.to >= SQUARES || move.from == move.to) {
+        return false;
+    }
+
+    const PackedPiece& piece = squares_[move.from];
+    const PackedPiece& target = squares_[move.to];
+    if (piece.type() == PieceType::None) {
+        return false;
+    }
+    bool target_empty = target.type() == PieceType::None;
+    if (!target_empty && target.getColor() == piece.getColor()) {
+        return false;
+    }
+
+    int from_row = move.from / BOARD_LENGTH;
+    int from_col = move.from % BOARD_LENGTH;
+    int to_row = move.to / BOARD_LENGTH;
+    int to_col = move.to % BOARD_LENGTH;
+
+    if (piece.type() == PieceType::Pawn) {
+        int direction = piece.isMovingUp() ? 1 : -1;
+        int last_row = piece.isMovingUp() ? BOARD_LENGTH - 1 : 0;
+        if ((move.flags & Move::PROMOTION) && to_row != last_row) {
+            return false;
+        }
+
+        // Diagonal capture
+        if (to_row == from_row + direction && (to_col == from_col + 1 || to_col == from_col - 1)) {
+            return !target_empty;
+        }
+        if (to_col != from_col || !target_empty) {
+            return false;
+        }
+        // Single step, or double jump over an empty square
+        if (to_row == from_row + direction) {
+            return true;
+        }
+        return to_row == from_row + 2 * direction && piece.canDoubleJump() &&
+               isEmpty(move.from + direction * BOARD_LENGTH);
+    }
+
+    if (move.flags & Move::PROMOTION) {
+        return false;
+    }
+
+    // Rook: along a row or column with nothing in between
+    if (from_row != to_row && from_col != to_col) {
+        return false;
+    }
+    int step = (from_row == to_row) ? (to_col > from_col ? 1 : -1)
+                                    : (to_row > from_row ? BOARD_LENGTH : -BOARD_LENGTH);
+    for (int square = move.from + step; square != move.to; square += step) {
+        if (!isEmpty(square)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Undo Board::makeMove(const Move& move) {
+    Undo undo;
+    undo.moved = squares_[move.from];
+    undo.captured = squares_[move.to];
+    undo.score = score_;
+    undo.pawn_key = pawn_key_;
+
+    PackedPiece piece = undo.moved;
+    piece.setPosition(move.to / BOARD_LENGTH, move.to % BOARD_LENGTH);
+    if (piece.type() == PieceType::Pawn) {
+        piece.setDoubleJump(false);
+        if (move.flags & Move::PROMOTION) {
+            piece.setType(PieceType::Rook);
+            piece.setCastleMovesLeft(0);
+        }
+    }
+
+    squares_[move.from] = PackedPiece();
+    squares_[move.to] = piece;
+    score_ += squareScore(piece, move.to) - squareScore(undo.moved, move.from) - squareScore(undo.captured, move.to);
+    pawn_key_ ^= pawnSquareKey(piece, move.to) ^ pawnSquareKey(undo.moved, move.from) ^ pawnSquareKey(undo.captured, move.to);
+    side_to_move_ = 1 - side_to_move_;
+    return undo;
+}
+
+void Board::unmakeMove(const Move& move, const Undo& undo) {
+    squares_[move.from] = undo.moved;
+    squares_[move.to] = undo.captured;
+    score_ = undo.score;
+    pawn_key_ = undo.pawn_key;
+    side_to_move_ = 1 - side_to_move_;
+}
+
+bool Board::operator==(const Board& other) const {
+    if (side_to_move_ != other.side_to_move_) {
+        return false;
+    }
+    for (int square = 0; square < SQUARES; square++) {
+        if (squares_[square] != other.squares_[square]) {
+            return false;
+        }
+    }
+    return true;
+}
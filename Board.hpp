@@ -0,0 +1,192 @@
+// File: Board.hpp
+// Date: 10/18/26
+// A compact 8x8 mailbox board of PackedPieces with a side to move
+
+#ifndef BOARD_HPP
+#define BOARD_HPP
+
+#include "Evaluation.hpp"
+#include "PackedPiece.hpp"
+#include <cstdint>
+
+/**
+ * @brief A move from one square to another. Squares are row * BOARD_LENGTH + column.
+ */
+struct Move {
+    static const std::uint8_t PROMOTION = 0x01;     // A pawn reaching its last row becomes a rook
+
+    std::uint8_t from = 0;      // Square the piece leaves
+    std::uint8_t to = 0;        // Square the piece lands on (capturing whatever is there)
+    std::uint8_t flags = 0;     // PROMOTION
+
+    Move() = default;
+    Move(int from_square, int to_square, std::uint8_t move_flags = 0) :
+        from(static_cast<std::uint8_t>(from_square)),
+        to(static_cast<std::uint8_t>(to_square)),
+        flags(move_flags) {}
+
+    /**
+     * @return The move in 16 bits: from in bits 0-5, to in bits 6-11, flags in bits 12-15
+     */
+    std::uint16_t encode() const {
+        return static_cast<std::uint16_t>((from & 0x3F) | (to & 0x3F) << 6 | (flags & 0x0F) << 12);
+    }
+
+    /**
+     * @brief Unpacks a move written by encode()
+     */
+    static Move decode(std::uint16_t bits) {
+        return Move(bits & 0x3F, (bits >> 6) & 0x3F, static_cast<std::uint8_t>(bits >> 12));
+    }
+
+    bool operator==(const Move& other) const { return from == other.from && to == other.to && flags == other.flags; }
+    bool operator!=(const Move& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief What makeMove() needs to hand back to unmakeMove() to restore the position
+ */
+struct Undo {
+    PackedPiece moved;      // The moving piece as it was before the move
+    PackedPiece captured;   // Whatever stood on the destination square (type NONE if nothing)
+    std::int32_t score;     // Board::evaluation() before the move
+    std::uint64_t pawn_key; // Board::pawnKey() before the move
+};
+
+/**
+ * @brief A position as 64 PackedPiece squares (NONE where empty) plus the side to move.
+ *      Players are indices, matching ChessBox's defaults: BLACK_PLAYER (0) is P1 "BLACK",
+ *      WHITE_PLAYER (1) is P2 "WHITE". White moves up the board (increasing rows).
+ *      The whole board is trivially copyable, so copying a position is a memcpy.
+ *      The static evaluation and the pawn key (see Evaluation.hpp) are kept up to date by every write but setSquare().
+ */
+class Board {
+    public:
+        static const int BOARD_LENGTH = PackedPiece::BOARD_LENGTH;
+        static const int SQUARES = BOARD_LENGTH * BOARD_LENGTH;
+        static const int BLACK_PLAYER = 0;
+        static const int WHITE_PLAYER = 1;
+
+    private:
+        PackedPiece squares_[SQUARES];  // Indexed by row * BOARD_LENGTH + column
+        int side_to_move_;              // Player index to move next
+        std::int32_t score_;            // Sum of squareScore() over the squares
+        std::uint64_t pawn_key_;        // XOR of pawnSquareKey() over the squares
+
+    public:
+        /**
+         * @brief Default constructor: an empty board with WHITE_PLAYER to move
+         */
+        Board();
+
+        /**
+         * @brief Removes every piece. The side to move is reset to WHITE_PLAYER.
+         */
+        void clear();
+
+        /**
+         * @brief Places a piece on the square given by its row and column, replacing whatever was there
+         * @return False (and nothing changes) if the piece is not on the board or has type NONE
+         */
+        bool place(const PackedPiece& piece) {
+            if (!piece.onBoard() || piece.type() == PieceType::None) {
+                return false;
+            }
+            int square = piece.square();
+            score_ += squareScore(piece, square) - squareScore(squares_[square], square);
+            pawn_key_ ^= pawnSquareKey(piece, square) ^ pawnSquareKey(squares_[square], square);
+            squares_[square] = piece;
+            return true;
+        }
+
+        /**
+         * @brief Writes a square without updating the evaluation or the pawn key, for loaders that
+         *      set up a whole position (eg. parseFen()) and then call rescore() once
+         * @pre 0 <= square < SQUARES, and piece is type NONE or stands on that square
+         */
+        void setSquare(int square, const PackedPiece& piece) { squares_[square] = piece; }
+
+        /**
+         * @brief Recomputes the evaluation and the pawn key from the squares, after setSquare()
+         */
+        void rescore();
+
+        /**
+         * @brief Empties a square
+         * @return The piece that was there (type NONE if the square was empty)
+         */
+        PackedPiece removeAt(int square) {
+            PackedPiece removed = squares_[square];
+            score_ -= squareScore(removed, square);
+            pawn_key_ ^= pawnSquareKey(removed, square);
+            squares_[square] = PackedPiece();
+            return removed;
+        }
+
+        /**
+         * @return The piece on the square (type NONE if empty)
+         * @pre 0 <= square < SQUARES
+         */
+        const PackedPiece& at(int square) const { return squares_[square]; }
+
+        /**
+         * @return The piece at (row, col) (type NONE if empty or off the board)
+         */
+        PackedPiece pieceAt(int row, int col) const;
+
+        /**
+         * @return True if the square holds no piece
+         */
+        bool isEmpty(int square) const { return squares_[square].type() == PieceType::None; }
+
+        int sideToMove() const { return side_to_move_; }
+        void setSideToMove(int player) { side_to_move_ = player; }
+
+        /**
+         * @return Material plus piece-square score for SCORED_PLAYER (WHITE_PLAYER), equal to
+         *      evaluate(*this) but maintained incrementally by place, removeAt and make/unmake. O(1).
+         */
+        std::int32_t evaluation() const { return score_; }
+
+        /**
+         * @return A Zobrist key of the pawns alone, equal for any two boards with the same pawns on
+         *      the same squares (0 with no pawns). Maintained like evaluation(). O(1).
+         */
+        std::uint64_t pawnKey() const { return pawn_key_; }
+
+        /**
+         * @brief Counts the pieces of a type belonging to a player, like ChessBox's count per color
+         */
+        int count(PieceType type, int player) const;
+
+        /**
+         * @brief Checks a move against the Pawn and Rook movement rules, ignoring whose turn it is:
+         *      - a pawn steps one row forward onto an empty square, two rows if it can double jump
+         *        and both squares are empty, or one row diagonally forward onto an enemy piece
+         *      - a rook slides along its row or column over empty squares, ending on an empty
+         *        square or an enemy piece
+         *      PROMOTION is only allowed for a pawn landing on its last row.
+         * @return True if the move is allowed
+         */
+        bool isPseudoLegal(const Move& move) const;
+
+        /**
+         * @brief Plays a move: the piece on move.from lands on move.to, capturing what was there,
+         *      and the side to move flips. A moved pawn loses its double jump, and with PROMOTION
+         *      it becomes a rook with no castle moves. The move is not validated.
+         * @return The information unmakeMove() needs to take the move back
+         */
+        Undo makeMove(const Move& move);
+
+        /**
+         * @brief Takes back a move made with makeMove(), restoring both squares and the side to move
+         */
+        void unmakeMove(const Move& move, const Undo& undo);
+
+        bool operator==(const Board& other) const;
+        bool operator!=(const Board& other) const { return !(*this == other); }
+};
+
+static_assert(Board::WHITE_PLAYER == SCORED_PLAYER, "The evaluation is from WHITE_PLAYER's point of view");
+
+#endif
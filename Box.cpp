@@ -0,0 +1,247 @@
+// File: Box.cpp
+// Date: 10/18/26
+// Implementation of the Box template class
+
+#ifndef BOX_CPP_
+#define BOX_CPP_
+
+#include "Box.hpp"
+#include <algorithm>
+#include <chrono>
+
+template <typename T, template <typename> class Storage>
+Box<T, Storage>::Box() : capacity_(64), size_(0), storage_(64) {
+}
+
+template <typename T, template <typename> class Storage>
+Box<T, Storage>::Box(const int& capacity) :
+    capacity_(capacity <= 0 ? 64 : capacity),
+    size_(0),
+    storage_(capacity <= 0 ? 64 : capacity) {
+}
+
+template <typename T, template <typename> class Storage>
+int Box<T, Storage>::size() const {
+    return size_;
+}
+
+template <typename T, template <typename> class Storage>
+int Box<T, Storage>::capacity() const {
+    return capacity_;
+}
+
+template <typename T, template <typename> class Storage>
+int Box<T, Storage>::length() const {
+    return storage_.length();
+}
+
+template <typename T, template <typename> class Storage>
+bool Box<T, Storage>::addItem(const T& item) {
+    int item_size = item.size();
+
+    // Check if adding this item would exceed capacity
+    if (size_ + item_size > capacity_) {
+        return false;
+    }
+
+    // The storage may still refuse (eg. a full InlineStorage)
+    if (!storage_.insert(item)) {
+        return false;
+    }
+
+    size_ += item_size;
+    return true;
+}
+
+template <typename T, template <typename> class Storage>
+bool Box<T, Storage>::remove(const std::string& type) {
+    T removed;
+    return remove(type, removed);
+}
+
+template <typename T, template <typename> class Storage>
+bool Box<T, Storage>::remove(const std::string& type, T& removed) {
+    if (!storage_.erase(type, removed)) {
+        return false;
+    }
+    size_ -= removed.size();
+    return true;
+}
+
+template <typename T, template <typename> class Storage>
+bool Box<T, Storage>::contains(const std::string& type) const {
+    return storage_.find(type) != nullptr;
+}
+
+template <typename T, template <typename> class Storage>
+const T* Box<T, Storage>::find(const std::string& type) const {
+    return storage_.find(type);
+}
+
+template <typename T, template <typename> class Storage>
+int Box<T, Storage>::count(const std::string& type) const {
+    return storage_.count(type);
+}
+
+template <typename T, template <typename> class Storage>
+bool Box<T, Storage>::addItems(const T* items, int count) {
+    return addItems(count, [items](int i) -> const T& { return items[i]; });
+}
+
+template <typename T, template <typename> class Storage>
+template <typename F>
+bool Box<T, Storage>::addItems(int count, F item) {
+    if (count < 0) {
+        return false;
+    }
+    int total = 0;
+    for (int i = 0; i < count; i++) {
+        total += item(i).size();
+    }
+    if (size_ + total > capacity_ || count > storage_.maxLength() - storage_.length()) {
+        return false;
+    }
+    if (!storage_.insertAll(count, item)) {
+        return false;
+    }
+    size_ += total;
+    return true;
+}
+
+template <typename T, template <typename> class Storage>
+bool Box<T, Storage>::hasItems(const std::string* types, int count) const {
+    // Count each distinct type once, at its first appearance
+    for (int i = 0; i < count; i++) {
+        bool first = true;
+        int needed = 0;
+        for (int j = 0; j < count; j++) {
+            if (types[j] == types[i]) {
+                first = first && j >= i;
+                needed++;
+            }
+        }
+        if (first && storage_.count(types[i]) < needed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T, template <typename> class Storage>
+bool Box<T, Storage>::removeItems(const std::string* types, int count, T* removed) {
+    // Check everything is there before touching anything
+    if (!hasItems(types, count)) {
+        return false;
+    }
+    for (int i = 0; i < count; i++) {
+        T item;
+        storage_.erase(types[i], item);
+        size_ -= item.size();
+        if (removed) {
+            removed[i] = std::move(item);
+        }
+    }
+    return true;
+}
+
+template <typename T, template <typename> class Storage>
+bool Box<T, Storage>::replaceAll(const T* items, int count) {
+    if (count < 0 || count > storage_.maxLength()) {
+        return false;
+    }
+    int total = 0;
+    for (int i = 0; i < count; i++) {
+        total += items[i].size();
+    }
+    if (total > capacity_) {
+        return false;
+    }
+    clear();
+    return addItems(items, count);
+}
+
+template <typename T, template <typename> class Storage>
+void Box<T, Storage>::clear() {
+    storage_.clear();
+    size_ = 0;
+}
+
+// Runs one mix of benchmarkBoxPolicies() on a Box with the given storage.
+// Returns ns per operation; `succeeded` counts the calls that returned true or found something.
+template <typename T, template <typename> class Storage>
+double timeBoxMix(const std::vector<T>& items, BoxMix mix, int rounds, long long& succeeded) {
+    typedef std::chrono::steady_clock Clock;
+    int count = static_cast<int>(items.size());
+    int capacity = 0;
+    std::vector<std::string> types;
+    for (const T& item : items) {
+        capacity += item.size();
+        types.push_back(item.getType());
+    }
+    Box<T, Storage> box(capacity);
+    if (mix == BoxMix::LookupHeavy) {
+        box.addItems(items.data(), count);
+    }
+
+    succeeded = 0;
+    long long operations = 0;
+    Clock::time_point start = Clock::now();
+    for (int round = 0; round < rounds; round++) {
+        const std::string& type = types[round % count];
+        if (mix == BoxMix::AddHeavy) {
+            box.clear();
+            for (const T& item : items) {
+                succeeded += box.addItem(item);
+            }
+            succeeded += box.count(type);
+            succeeded += box.remove(type);
+            operations += count + 2;
+        } else if (mix == BoxMix::RemoveHeavy) {
+            succeeded += box.addItems(items.data(), count);
+            for (const std::string& each : types) {
+                succeeded += box.remove(each);
+            }
+            operations += count + 1;
+        } else {
+            for (const std::string& each : types) {
+                succeeded += box.contains(each);
+                succeeded += box.count(each);
+            }
+            T removed;
+            succeeded += box.remove(type, removed);
+            succeeded += box.addItem(removed);
+            operations += 2 * count + 2;
+        }
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / operations;
+}
+
+template <typename T>
+std::vector<BoxBenchmark> benchmarkBoxPolicies(const std::vector<T>& items, int rounds) {
+    std::vector<BoxBenchmark> results;
+    if (items.empty()) {
+        return results;
+    }
+    std::vector<T> working(items.begin(), items.begin() + std::min<std::size_t>(items.size(), InlineStorage<T>::kInlineItems));
+    rounds = rounds < 1 ? 1 : rounds;
+
+    for (int mix = 0; mix < BOX_MIXES; mix++) {
+        BoxBenchmark row;
+        row.mix = static_cast<BoxMix>(mix);
+        row.items = static_cast<int>(working.size());
+
+        // Every policy has the same contract, so they must all report the same successes
+        long long succeeded[4];
+        row.array_ns = timeBoxMix<T, ArrayStorage>(working, row.mix, rounds, succeeded[0]);
+        row.linked_ns = timeBoxMix<T, LinkedStorage>(working, row.mix, rounds, succeeded[1]);
+        row.unrolled_ns = timeBoxMix<T, UnrolledStorage>(working, row.mix, rounds, succeeded[2]);
+        row.inline_ns = timeBoxMix<T, InlineStorage>(working, row.mix, rounds, succeeded[3]);
+        if (succeeded[1] != succeeded[0] || succeeded[2] != succeeded[0] || succeeded[3] != succeeded[0]) {
+            row.items = -1;
+        }
+        results.push_back(row);
+    }
+    return results;
+}
+
+#endif // BOX_CPP_
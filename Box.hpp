@@ -0,0 +1,214 @@
+// File: Box.hpp
+// Date: 10/18/26
+// A template container with the ArrayBox/LinkedBox contract whose memory
+// layout is chosen at compile time by a storage policy (see BoxStorage.hpp),
+// and a benchmark comparing the policies
+
+#ifndef BOX_HPP_
+#define BOX_HPP_
+
+#include <string>
+#include <vector>
+#include "BoxStorage.hpp"
+
+/**
+ * @brief A capacity-limited container of items that each occupy `item.size()` units.
+ *      Box keeps the capacity accounting; the Storage policy decides the layout:
+ *          Box<T, ArrayStorage>    - contiguous array (ArrayBox-like)
+ *          Box<T, LinkedStorage>   - head-inserted chain (LinkedBox is this Box)
+ *          Box<T, UnrolledStorage> - chain of fixed-size chunks
+ *          Box<T, InlineStorage>   - fixed in-object buffer, no heap allocation
+ *      All calls are resolved statically; there is no virtual dispatch.
+ *      ArrayBox stays a class of its own: it copies an item into each of its size() spaces,
+ *      reuses gaps best-fit, grows on demand and shares that space layout with the files
+ *      MappedArrayBox maps, none of which fits a policy that stores one entry per item.
+ */
+template <typename T, template <typename> class Storage>
+class Box {
+    private:
+        int capacity_;          // Maximum total size of the stored items
+        int size_;              // Current total size of the stored items
+        Storage<T> storage_;    // Layout policy holding the items
+
+    public:
+        /**
+         * @brief Default constructor
+         * @post Initializes capacity_ to 64 and size_ to 0.
+         */
+        Box();
+
+        /**
+         * @brief Parameterized constructor
+         * @param capacity A const reference to an integer to specify the capacity of the Box
+         * @post Initializes capacity_ to the specified parameter and size_ to 0.
+         * @note If the capacity is 0 or negative, 64 is used instead
+         */
+        Box(const int& capacity);
+
+        /**
+         * @brief Getter for the size_ member
+         * @return The integer value stored within the size_ member variable
+         */
+        int size() const;
+
+        /**
+         * @brief Getter for the capacity_ member
+         * @return The integer value stored within the capacity_ member variable
+         */
+        int capacity() const;
+
+        /**
+         * @brief Getter for the number of stored items (as opposed to the space they take up)
+         * @return The number of items held by the storage policy
+         */
+        int length() const;
+
+        /**
+         * @return The most items the storage policy can hold, whatever their size
+         */
+        int maxLength() const { return storage_.maxLength(); }
+
+        /**
+         * @brief Adds the item if size_ + item.size() does not exceed capacity_
+         *      and the storage policy has room for it.
+         * @param item A const reference to the item to be added
+         * @return True if the add was successful. False otherwise.
+         * @post Increment size_ (if the item was added) by the size of the added object.
+         */
+        bool addItem(const T& item);
+
+        /**
+         * @brief Adds all the items or none: the total size is checked against the capacity once,
+         *      and the storage inserts them in one pass, in order, as addItem() on each would
+         * @return True if every item was added. False otherwise (the Box is unchanged).
+         */
+        bool addItems(const T* items, int count);
+
+        /**
+         * @brief Same as addItems(items, count) for the items returned by item(0) .. item(count - 1)
+         *      as const T&. item(i) is called twice per index: once for the size, once to insert.
+         */
+        template <typename F>
+        bool addItems(int count, F item);
+
+        /**
+         * @brief Removes one item per entry of types (repeat a type to remove several), all or none
+         * @param removed If not nullptr, receives the removed items, count of them, in types order
+         * @return True if every removal was possible and done. False otherwise (the Box is unchanged).
+         */
+        bool removeItems(const std::string* types, int count, T* removed = nullptr);
+
+        /**
+         * @return True if the Box holds at least as many items of each type as it appears in types,
+         *      ie. if removeItems(types, count) would succeed
+         */
+        bool hasItems(const std::string* types, int count) const;
+
+        /**
+         * @brief Replaces the contents with the given items, all or none
+         * @return True if the items fit. False otherwise (the Box keeps its old items).
+         */
+        bool replaceAll(const T* items, int count);
+
+        /**
+         * @brief Removes the first item (in the storage's iteration order) whose getType() equals type
+         * @param type A const reference to a string specifying the type of the object to remove
+         * @return True if an item was removed. False otherwise.
+         * @post size_ is decremented by the size of the removed item.
+         */
+        bool remove(const std::string& type);
+
+        /**
+         * @brief Same as remove(type), but also hands back the removed item
+         * @param type A const reference to a string specifying the type of the object to remove
+         * @param removed Receives the removed item if one was found
+         * @return True if an item was removed. False otherwise.
+         */
+        bool remove(const std::string& type, T& removed);
+
+        /**
+         * @param type A const reference to a string denoting the type of the item to search for
+         * @return True if the Box holds an object whose getType() equals the given parameter
+         */
+        bool contains(const std::string& type) const;
+
+        /**
+         * @param type A const reference to a string denoting the type of the item to search for
+         * @return A pointer to the first matching item, or nullptr if there is none.
+         *      The pointer is invalidated by the next addItem/remove.
+         */
+        const T* find(const std::string& type) const;
+
+        /**
+         * @param type A const reference to a string denoting the type of the item to search for
+         * @return The number of stored items whose getType() equals the given parameter
+         */
+        int count(const std::string& type) const;
+
+        /**
+         * @brief Removes every item and resets size_ to 0. The capacity is unchanged.
+         */
+        void clear();
+
+        /**
+         * @brief Calls f(item) for every stored item in the storage's iteration order
+         */
+        template <typename F>
+        void forEach(F f) const {
+            storage_.forEach(f);
+        }
+
+        /**
+         * @brief Finds the first item (in the storage's iteration order) the predicate accepts, for
+         *      in-place updates that keep its size (eg. moving a piece)
+         * @return A pointer to the item, or nullptr. Invalidated by the next addItem/remove.
+         */
+        template <typename P>
+        T* findIf(P predicate) {
+            return storage_.findIf(predicate);
+        }
+};
+
+/**
+ * @brief The operation mixes benchmarkBoxPolicies() runs
+ */
+enum class BoxMix {
+    AddHeavy = 0,       // addItem() each item into an empty box, then one count() and one remove()
+    RemoveHeavy = 1,    // one addItems() of every item, then a remove() of each item's type
+    LookupHeavy = 2     // a contains() and a count() of each item's type on a full box, then one
+                        // remove() and an addItem() putting the removed item back
+};
+
+const int BOX_MIXES = 3;
+
+/**
+ * @return "add-heavy", "remove-heavy" or "lookup-heavy"
+ */
+inline const char* boxMixName(BoxMix mix) {
+    static const char* const NAMES[BOX_MIXES] = { "add-heavy", "remove-heavy", "lookup-heavy" };
+    return NAMES[static_cast<int>(mix)];
+}
+
+/**
+ * @brief One row of benchmarkBoxPolicies(): nanoseconds per operation of one operation mix
+ *      on a Box of each storage policy
+ */
+struct BoxBenchmark {
+    BoxMix mix = BoxMix::AddHeavy;
+    int items = 0;              // Items in the working set; -1 if the policies disagreed on a result
+    double array_ns = 0;        // Box<T, ArrayStorage>
+    double linked_ns = 0;       // Box<T, LinkedStorage>
+    double unrolled_ns = 0;     // Box<T, UnrolledStorage>
+    double inline_ns = 0;       // Box<T, InlineStorage>
+};
+
+/**
+ * @brief Storage policy matrix: runs each BoxMix `rounds` times on a Box of every policy,
+ *      over the first InlineStorage<T>::kInlineItems items at most, in a box just big enough
+ * @return One row per mix, in BoxMix order; empty if there are no items
+ */
+template <typename T>
+std::vector<BoxBenchmark> benchmarkBoxPolicies(const std::vector<T>& items, int rounds = 10000);
+
+#include "Box.cpp"
+#endif // BOX_HPP_
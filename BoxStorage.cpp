@@ -0,0 +1,546 @@
+// File: BoxStorage.cpp
+// Date: 10/18/26
+// Implementation of the Box storage policies
+
+#ifndef BOX_STORAGE_CPP_
+#define BOX_STORAGE_CPP_
+
+#include "BoxStorage.hpp"
+#include <new>
+#include <utility>
+
+/////////////////////////////// ArrayStorage /////////////////////////////////
+
+template <typename T>
+ArrayStorage<T>::ArrayStorage(int capacity_hint) : length_(0) {
+    // A box of capacity n never holds more than n sized items, so start there
+    slots_ = (capacity_hint <= 0) ? 64 : capacity_hint;
+    items_ = new T[slots_];
+}
+
+template <typename T>
+ArrayStorage<T>::ArrayStorage(const ArrayStorage& other) :
+    items_(new T[other.slots_]),
+    length_(other.length_),
+    slots_(other.slots_) {
+    for (int i = 0; i < length_; i++) {
+        items_[i] = other.items_[i];
+    }
+}
+
+template <typename T>
+ArrayStorage<T>& ArrayStorage<T>::operator=(const ArrayStorage& other) {
+    if (this != &other) {
+        ArrayStorage copy(other);
+        std::swap(items_, copy.items_);
+        std::swap(length_, copy.length_);
+        std::swap(slots_, copy.slots_);
+    }
+    return *this;
+}
+
+template <typename T>
+ArrayStorage<T>::~ArrayStorage() {
+    delete[] items_;
+}
+
+// Doubles the array. Only reached by zero-sized items, which do not count against capacity.
+template <typename T>
+void ArrayStorage<T>::grow() {
+    T* larger = new T[slots_ * 2];
+    for (int i = 0; i < length_; i++) {
+        larger[i] = std::move(items_[i]);
+    }
+    delete[] items_;
+    items_ = larger;
+    slots_ *= 2;
+}
+
+template <typename T>
+bool ArrayStorage<T>::insert(const T& item) {
+    if (length_ == slots_) {
+        grow();
+    }
+    items_[length_++] = item;
+    return true;
+}
+
+template <typename T>
+template <typename F>
+bool ArrayStorage<T>::insertAll(int count, F item) {
+    // Grow once to the final length instead of doubling along the way
+    if (length_ + count > slots_) {
+        int slots = length_ + count;
+        T* larger = new T[slots];
+        for (int i = 0; i < length_; i++) {
+            larger[i] = std::move(items_[i]);
+        }
+        delete[] items_;
+        items_ = larger;
+        slots_ = slots;
+    }
+    for (int i = 0; i < count; i++) {
+        items_[length_++] = item(i);
+    }
+    return true;
+}
+
+template <typename T>
+bool ArrayStorage<T>::erase(const std::string& type, T& removed) {
+    for (int i = 0; i < length_; i++) {
+        if (items_[i].getType() == type) {
+            removed = std::move(items_[i]);
+
+            // Shift the later items left by one entry
+            for (int j = i; j + 1 < length_; j++) {
+                items_[j] = std::move(items_[j + 1]);
+            }
+            items_[--length_] = T();
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+const T* ArrayStorage<T>::find(const std::string& type) const {
+    for (int i = 0; i < length_; i++) {
+        if (items_[i].getType() == type) {
+            return &items_[i];
+        }
+    }
+    return nullptr;
+}
+
+template <typename T>
+int ArrayStorage<T>::count(const std::string& type) const {
+    int count = 0;
+    for (int i = 0; i < length_; i++) {
+        if (items_[i].getType() == type) {
+            count++;
+        }
+    }
+    return count;
+}
+
+template <typename T>
+void ArrayStorage<T>::clear() {
+    for (int i = 0; i < length_; i++) {
+        items_[i] = T();
+    }
+    length_ = 0;
+}
+
+/////////////////////////////// LinkedStorage /////////////////////////////////
+
+template <typename T>
+LinkedStorage<T>::LinkedStorage(int) : head_(nullptr), length_(0), free_(nullptr), spare_(0) {
+    // Nodes are allocated on demand, so the capacity hint is unused
+}
+
+template <typename T>
+void LinkedStorage<T>::reserve(int count) {
+    if (count <= spare_) {
+        return;
+    }
+    int nodes = count - spare_;
+    ListNode* block = new ListNode[nodes];
+    for (int i = 0; i < nodes; i++) {
+        block[i].next = (i + 1 < nodes) ? &block[i + 1] : free_;
+    }
+    free_ = block;
+    spare_ += nodes;
+    blocks_.push_back(block);
+}
+
+template <typename T>
+void LinkedStorage<T>::push(const T& item) {
+    ListNode* node = free_;
+    free_ = node->next;
+    spare_--;
+    node->value = item;
+    node->next = head_;
+    head_ = node;
+    length_++;
+}
+
+// Copies the chain of `other` onto the end of this (empty) storage, preserving order
+template <typename T>
+void LinkedStorage<T>::copyFrom(const LinkedStorage& other) {
+    reserve(other.length_);
+    ListNode** tail = &head_;
+    for (ListNode* current = other.head_; current; current = current->next) {
+        ListNode* node = free_;
+        free_ = node->next;
+        spare_--;
+        node->value = current->value;
+        node->next = nullptr;
+        *tail = node;
+        tail = &node->next;
+    }
+    length_ = other.length_;
+}
+
+template <typename T>
+LinkedStorage<T>::LinkedStorage(const LinkedStorage& other) : head_(nullptr), length_(0), free_(nullptr), spare_(0) {
+    copyFrom(other);
+}
+
+template <typename T>
+LinkedStorage<T>& LinkedStorage<T>::operator=(const LinkedStorage& other) {
+    if (this != &other) {
+        clear();
+        copyFrom(other);
+    }
+    return *this;
+}
+
+template <typename T>
+LinkedStorage<T>::~LinkedStorage() {
+    clear();
+}
+
+template <typename T>
+bool LinkedStorage<T>::insert(const T& item) {
+    // Blocks grow with the chain, from 4 nodes up to 64
+    if (spare_ == 0) {
+        reserve(length_ < 4 ? 4 : (length_ > 64 ? 64 : length_));
+    }
+    push(item);
+    return true;
+}
+
+template <typename T>
+template <typename F>
+bool LinkedStorage<T>::insertAll(int count, F item) {
+    // One block for whatever the free list cannot cover; the last item ends up at the head,
+    // as with insert()
+    reserve(count);
+    for (int i = 0; i < count; i++) {
+        push(item(i));
+    }
+    return true;
+}
+
+template <typename T>
+bool LinkedStorage<T>::erase(const std::string& type, T& removed) {
+    // Walk the chain through the link that points at each node, so the head needs no special case
+    for (ListNode** link = &head_; *link; link = &(*link)->next) {
+        if ((*link)->value.getType() == type) {
+            ListNode* to_remove = *link;
+            *link = to_remove->next;
+            removed = std::move(to_remove->value);
+            to_remove->value = T();
+            to_remove->next = free_;
+            free_ = to_remove;
+            spare_++;
+            length_--;
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+const T* LinkedStorage<T>::find(const std::string& type) const {
+    for (ListNode* current = head_; current; current = current->next) {
+        if (current->value.getType() == type) {
+            return &current->value;
+        }
+    }
+    return nullptr;
+}
+
+template <typename T>
+int LinkedStorage<T>::count(const std::string& type) const {
+    int count = 0;
+    for (ListNode* current = head_; current; current = current->next) {
+        if (current->value.getType() == type) {
+            count++;
+        }
+    }
+    return count;
+}
+
+template <typename T>
+void LinkedStorage<T>::clear() {
+    for (ListNode* block : blocks_) {
+        delete[] block;
+    }
+    blocks_.clear();
+    head_ = nullptr;
+    length_ = 0;
+    free_ = nullptr;
+    spare_ = 0;
+}
+
+/////////////////////////////// UnrolledStorage /////////////////////////////////
+
+template <typename T>
+UnrolledStorage<T>::UnrolledStorage(int) : head_(nullptr), length_(0), free_(nullptr), spare_(0) {
+    // Chunks are allocated on demand, so the capacity hint is unused
+}
+
+template <typename T>
+void UnrolledStorage<T>::reserve(int count) {
+    if (count <= spare_) {
+        return;
+    }
+    int chunks = count - spare_;
+    Chunk* block = new Chunk[chunks];
+    for (int i = 0; i < chunks; i++) {
+        block[i].used = 0;
+        block[i].next = (i + 1 < chunks) ? &block[i + 1] : free_;
+    }
+    free_ = block;
+    spare_ += chunks;
+    blocks_.push_back(block);
+}
+
+template <typename T>
+void UnrolledStorage<T>::pushChunk() {
+    Chunk* chunk = free_;
+    free_ = chunk->next;
+    spare_--;
+    chunk->used = 0;
+    chunk->next = head_;
+    head_ = chunk;
+}
+
+template <typename T>
+void UnrolledStorage<T>::copyFrom(const UnrolledStorage& other) {
+    int chunks = 0;
+    for (Chunk* chunk = other.head_; chunk; chunk = chunk->next) {
+        chunks++;
+    }
+    reserve(chunks);
+    Chunk** tail = &head_;
+    for (Chunk* chunk = other.head_; chunk; chunk = chunk->next) {
+        Chunk* copy = free_;
+        free_ = copy->next;
+        spare_--;
+        for (int i = 0; i < chunk->used; i++) {
+            copy->items[i] = chunk->items[i];
+        }
+        copy->used = chunk->used;
+        copy->next = nullptr;
+        *tail = copy;
+        tail = &copy->next;
+    }
+    length_ = other.length_;
+}
+
+template <typename T>
+UnrolledStorage<T>::UnrolledStorage(const UnrolledStorage& other) : head_(nullptr), length_(0), free_(nullptr), spare_(0) {
+    copyFrom(other);
+}
+
+template <typename T>
+UnrolledStorage<T>& UnrolledStorage<T>::operator=(const UnrolledStorage& other) {
+    if (this != &other) {
+        clear();
+        copyFrom(other);
+    }
+    return *this;
+}
+
+template <typename T>
+UnrolledStorage<T>::~UnrolledStorage() {
+    clear();
+}
+
+template <typename T>
+bool UnrolledStorage<T>::insert(const T& item) {
+    // Start a new head chunk once the current one is full
+    if (!head_ || head_->used == kChunkItems) {
+        reserve(1);
+        pushChunk();
+    }
+    head_->items[head_->used++] = item;
+    length_++;
+    return true;
+}
+
+template <typename T>
+template <typename F>
+bool UnrolledStorage<T>::insertAll(int count, F item) {
+    // Reserve every chunk the batch will start, as one block
+    int room = head_ ? kChunkItems - head_->used : 0;
+    reserve(count > room ? (count - room + kChunkItems - 1) / kChunkItems : 0);
+    for (int i = 0; i < count; i++) {
+        if (!head_ || head_->used == kChunkItems) {
+            pushChunk();
+        }
+        head_->items[head_->used++] = item(i);
+    }
+    length_ += count;
+    return true;
+}
+
+template <typename T>
+bool UnrolledStorage<T>::erase(const std::string& type, T& removed) {
+    for (Chunk** link = &head_; *link; link = &(*link)->next) {
+        Chunk* chunk = *link;
+        for (int i = 0; i < chunk->used; i++) {
+            if (chunk->items[i].getType() == type) {
+                removed = std::move(chunk->items[i]);
+
+                // Close the gap inside the chunk to keep its items in order
+                for (int j = i; j + 1 < chunk->used; j++) {
+                    chunk->items[j] = std::move(chunk->items[j + 1]);
+                }
+                chunk->items[--chunk->used] = T();
+                length_--;
+
+                // Unlink chunks that became empty and keep them for later inserts
+                if (chunk->used == 0) {
+                    *link = chunk->next;
+                    chunk->next = free_;
+                    free_ = chunk;
+                    spare_++;
+                }
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template <typename T>
+const T* UnrolledStorage<T>::find(const std::string& type) const {
+    for (Chunk* chunk = head_; chunk; chunk = chunk->next) {
+        for (int i = 0; i < chunk->used; i++) {
+            if (chunk->items[i].getType() == type) {
+                return &chunk->items[i];
+            }
+        }
+    }
+    return nullptr;
+}
+
+template <typename T>
+int UnrolledStorage<T>::count(const std::string& type) const {
+    int count = 0;
+    for (Chunk* chunk = head_; chunk; chunk = chunk->next) {
+        for (int i = 0; i < chunk->used; i++) {
+            if (chunk->items[i].getType() == type) {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+template <typename T>
+void UnrolledStorage<T>::clear() {
+    for (Chunk* block : blocks_) {
+        delete[] block;
+    }
+    blocks_.clear();
+    head_ = nullptr;
+    length_ = 0;
+    free_ = nullptr;
+    spare_ = 0;
+}
+
+/////////////////////////////// InlineStorage /////////////////////////////////
+
+template <typename T>
+InlineStorage<T>::InlineStorage(int) : length_(0) {
+    // The buffer is a fixed member, so the capacity hint is unused
+}
+
+template <typename T>
+InlineStorage<T>::InlineStorage(const InlineStorage& other) : length_(0) {
+    for (int i = 0; i < other.length_; i++) {
+        new (slot(i)) T(*other.slot(i));
+        length_++;
+    }
+}
+
+template <typename T>
+InlineStorage<T>& InlineStorage<T>::operator=(const InlineStorage& other) {
+    if (this != &other) {
+        clear();
+        for (int i = 0; i < other.length_; i++) {
+            new (slot(i)) T(*other.slot(i));
+            length_++;
+        }
+    }
+    return *this;
+}
+
+template <typename T>
+InlineStorage<T>::~InlineStorage() {
+    clear();
+}
+
+template <typename T>
+bool InlineStorage<T>::insert(const T& item) {
+    if (length_ == kInlineItems) {
+        return false;
+    }
+    new (slot(length_)) T(item);
+    length_++;
+    return true;
+}
+
+template <typename T>
+template <typename F>
+bool InlineStorage<T>::insertAll(int count, F item) {
+    if (length_ + count > kInlineItems) {
+        return false;
+    }
+    for (int i = 0; i < count; i++) {
+        new (slot(length_)) T(item(i));
+        length_++;
+    }
+    return true;
+}
+
+template <typename T>
+bool InlineStorage<T>::erase(const std::string& type, T& removed) {
+    for (int i = 0; i < length_; i++) {
+        if (slot(i)->getType() == type) {
+            removed = std::move(*slot(i));
+
+            // Shift the later items left, then destroy the vacated last slot
+            for (int j = i; j + 1 < length_; j++) {
+                *slot(j) = std::move(*slot(j + 1));
+            }
+            slot(--length_)->~T();
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+const T* InlineStorage<T>::find(const std::string& type) const {
+    for (int i = 0; i < length_; i++) {
+        if (slot(i)->getType() == type) {
+            return slot(i);
+        }
+    }
+    return nullptr;
+}
+
+template <typename T>
+int InlineStorage<T>::count(const std::string& type) const {
+    int count = 0;
+    for (int i = 0; i < length_; i++) {
+        if (slot(i)->getType() == type) {
+            count++;
+        }
+    }
+    return count;
+}
+
+template <typename T>
+void InlineStorage<T>::clear() {
+    while (length_ > 0) {
+        slot(--length_)->~T();
+    }
+}
+
+#endif // BOX_STORAGE_CPP_
@@ -0,0 +1,266 @@
+// File: BoxStorage.hpp
+// Date: 10/18/26
+// Storage policies that plug into Box<T, Storage>. Each policy only decides
+// how items are laid out in memory; capacity accounting lives in Box.
+//
+// Every policy is a class template over the item type T and provides:
+//      explicit Policy(int capacity_hint);
+//      bool insert(const T& item);                          // false if the storage itself is full
+//      bool erase(const std::string& type, T& removed);     // removes the first match in iteration order
+//      const T* find(const std::string& type) const;
+//      int count(const std::string& type) const;
+//      int length() const;                                  // number of stored items
+//      int maxLength() const;                               // most items the storage can ever hold
+//      template <typename F> bool insertAll(int count, F item);
+//          // inserts item(0) .. item(count - 1) as count insert() calls would, allocating
+//          // once where the layout allows; false (nothing inserted) past maxLength()
+//      void clear();
+//      template <typename F> void forEach(F f) const;
+//      template <typename P> T* findIf(P predicate);         // first item in iteration order, or nullptr
+// plus value semantics (copy constructor / copy assignment / destructor).
+
+#ifndef BOX_STORAGE_HPP_
+#define BOX_STORAGE_HPP_
+
+#include <climits>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Contiguous storage: one array entry per item, appended at the back.
+ *      Removal shifts later items left by one entry to keep insertion order,
+ *      which mirrors ArrayBox but without replicating an item across size() slots.
+ */
+template <typename T>
+class ArrayStorage {
+    private:
+        T* items_;      // Dynamic array holding the items
+        int length_;    // Number of items stored
+        int slots_;     // Allocated length of items_
+
+        void grow();
+
+    public:
+        explicit ArrayStorage(int capacity_hint);
+        ArrayStorage(const ArrayStorage& other);
+        ArrayStorage& operator=(const ArrayStorage& other);
+        ~ArrayStorage();
+
+        bool insert(const T& item);
+        bool erase(const std::string& type, T& removed);
+        const T* find(const std::string& type) const;
+        int count(const std::string& type) const;
+        int length() const { return length_; }
+        int maxLength() const { return INT_MAX; }
+        void clear();
+
+        template <typename F>
+        bool insertAll(int count, F item);
+
+        template <typename F>
+        void forEach(F f) const {
+            for (int i = 0; i < length_; i++) {
+                f(items_[i]);
+            }
+        }
+
+        template <typename P>
+        T* findIf(P predicate) {
+            for (int i = 0; i < length_; i++) {
+                if (predicate(items_[i])) {
+                    return &items_[i];
+                }
+            }
+            return nullptr;
+        }
+};
+
+/**
+ * @brief Singly linked storage that inserts at the head, like LinkedBox.
+ *      Iteration order is therefore newest-first.
+ *      Nodes come from blocks owned by the storage: insertAll() allocates one block for the
+ *      whole batch, and erase() hands its node back to a free list for later inserts.
+ *      Blocks are only released by clear() and the destructor.
+ */
+template <typename T>
+class LinkedStorage {
+    private:
+        struct ListNode {
+            T value;        // T() while the node is spare
+            ListNode* next;
+        };
+
+        ListNode* head_;    // Most recently inserted item
+        int length_;        // Number of nodes in the chain
+        ListNode* free_;    // Spare nodes, linked through next
+        int spare_;         // Number of nodes on free_
+        std::vector<ListNode*> blocks_;     // Node arrays allocated by reserve()
+
+        // Allocates one block so that at least `count` nodes are spare
+        void reserve(int count);
+
+        // Links item in front of the head, on a spare node
+        void push(const T& item);
+
+        void copyFrom(const LinkedStorage& other);
+
+    public:
+        explicit LinkedStorage(int capacity_hint);
+        LinkedStorage(const LinkedStorage& other);
+        LinkedStorage& operator=(const LinkedStorage& other);
+        ~LinkedStorage();
+
+        bool insert(const T& item);
+        bool erase(const std::string& type, T& removed);
+        const T* find(const std::string& type) const;
+        int count(const std::string& type) const;
+        int length() const { return length_; }
+        int maxLength() const { return INT_MAX; }
+        void clear();
+
+        template <typename F>
+        bool insertAll(int count, F item);
+
+        template <typename F>
+        void forEach(F f) const {
+            for (ListNode* current = head_; current; current = current->next) {
+                f(current->value);
+            }
+        }
+
+        template <typename P>
+        T* findIf(P predicate) {
+            for (ListNode* current = head_; current; current = current->next) {
+                if (predicate(current->value)) {
+                    return &current->value;
+                }
+            }
+            return nullptr;
+        }
+};
+
+/**
+ * @brief Unrolled linked list: a chain of fixed-size chunks inserted at the head.
+ *      Scans touch one node per kChunkItems items instead of one node per item.
+ *      Chunks are pooled like LinkedStorage's nodes: insertAll() allocates the chunks a batch
+ *      needs as one block, and a chunk emptied by erase() is kept for later inserts.
+ */
+template <typename T>
+class UnrolledStorage {
+    public:
+        static const int kChunkItems = 16;     // Items held by each chunk
+
+    private:
+        struct Chunk {
+            T items[kChunkItems];
+            int used;
+            Chunk* next;
+        };
+
+        Chunk* head_;       // Chunk receiving new items
+        int length_;        // Number of items across all chunks
+        Chunk* free_;       // Spare chunks (every item T()), linked through next
+        int spare_;         // Number of chunks on free_
+        std::vector<Chunk*> blocks_;    // Chunk arrays allocated by reserve()
+
+        // Allocates one block so that at least `count` chunks are spare
+        void reserve(int count);
+
+        // Makes a spare chunk the new, empty head
+        void pushChunk();
+
+        void copyFrom(const UnrolledStorage& other);
+
+    public:
+        explicit UnrolledStorage(int capacity_hint);
+        UnrolledStorage(const UnrolledStorage& other);
+        UnrolledStorage& operator=(const UnrolledStorage& other);
+        ~UnrolledStorage();
+
+        bool insert(const T& item);
+        bool erase(const std::string& type, T& removed);
+        const T* find(const std::string& type) const;
+        int count(const std::string& type) const;
+        int length() const { return length_; }
+        int maxLength() const { return INT_MAX; }
+        void clear();
+
+        template <typename F>
+        bool insertAll(int count, F item);
+
+        template <typename F>
+        void forEach(F f) const {
+            for (Chunk* chunk = head_; chunk; chunk = chunk->next) {
+                for (int i = 0; i < chunk->used; i++) {
+                    f(chunk->items[i]);
+                }
+            }
+        }
+
+        template <typename P>
+        T* findIf(P predicate) {
+            for (Chunk* chunk = head_; chunk; chunk = chunk->next) {
+                for (int i = 0; i < chunk->used; i++) {
+                    if (predicate(chunk->items[i])) {
+                        return &chunk->items[i];
+                    }
+                }
+            }
+            return nullptr;
+        }
+};
+
+/**
+ * @brief Fixed inline storage with no heap allocation. Slots are left
+ *      unconstructed until used. Holds at most kInlineItems items;
+ *      insert() fails once they are all taken.
+ */
+template <typename T>
+class InlineStorage {
+    public:
+        static const int kInlineItems = 64;    // Enough for a full 64-slot box of size-1 pieces
+
+    private:
+        alignas(T) unsigned char buffer_[sizeof(T) * kInlineItems];
+        int length_;    // Number of constructed items at the front of buffer_
+
+        T* slot(int index) { return reinterpret_cast<T*>(buffer_) + index; }
+        const T* slot(int index) const { return reinterpret_cast<const T*>(buffer_) + index; }
+
+    public:
+        explicit InlineStorage(int capacity_hint);
+        InlineStorage(const InlineStorage& other);
+        InlineStorage& operator=(const InlineStorage& other);
+        ~InlineStorage();
+
+        bool insert(const T& item);
+        bool erase(const std::string& type, T& removed);
+        const T* find(const std::string& type) const;
+        int count(const std::string& type) const;
+        int length() const { return length_; }
+        int maxLength() const { return kInlineItems; }
+        void clear();
+
+        template <typename F>
+        bool insertAll(int count, F item);
+
+        template <typename F>
+        void forEach(F f) const {
+            for (int i = 0; i < length_; i++) {
+                f(*slot(i));
+            }
+        }
+
+        template <typename P>
+        T* findIf(P predicate) {
+            for (int i = 0; i < length_; i++) {
+                if (predicate(*slot(i))) {
+                    return slot(i);
+                }
+            }
+            return nullptr;
+        }
+};
+
+#include "BoxStorage.cpp"
+#endif // BOX_STORAGE_HPP_
@@ -0,0 +1,44 @@
+// File: ChangeFeed.cpp
+// Date: 10/18/26
+// Implementation of the ChangeFeed class
+
+#include "ChangeFeed.hpp"
+
+ChangeFeed::ChangeFeed(std::size_t capacity) :
+    ring_(capacity),
+    next_sequence_(0),
+    published_(0),
+    dropped_(0) {
+}
+
+bool ChangeFeed::publish(ChangeKind kind, int player, const PackedPiece& piece, int size,
+                         int from_row, int from_column) {
+    ChangeRecord record;
+    record.sequence = 0;
+    record.kind = kind;
+    record.player = static_cast<std::uint8_t>(player);
+    record.piece = piece;
+    record.from_row = static_cast<std::int8_t>(from_row);
+    record.from_column = static_cast<std::int8_t>(from_column);
+    record.size = static_cast<std::uint8_t>(size < 0 ? 0 : (size > 255 ? 255 : size));
+    record.reserved = 0;
+    return publish(record);
+}
+
+std::size_t ChangeFeed::drain(std::vector<ChangeRecord>& out, std::size_t max) {
+    // Copy straight into the vector in chunks, so a large backlog costs few release stores
+    const std::size_t CHUNK = 256;
+    std::size_t total = 0;
+    while (total < max) {
+        std::size_t want = (max - total < CHUNK) ? max - total : CHUNK;
+        std::size_t start = out.size();
+        out.resize(start + want);
+        std::size_t got = ring_.popBatch(out.data() + start, want);
+        out.resize(start + got);
+        total += got;
+        if (got < want) {
+            break;
+        }
+    }
+    return total;
+}
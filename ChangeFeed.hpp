@@ -0,0 +1,105 @@
+// File: ChangeFeed.hpp
+// Date: 10/18/26
+// Fixed-size ChessBox change records published through an SPSC ring
+
+#ifndef CHANGE_FEED_HPP
+#define CHANGE_FEED_HPP
+
+#include "PackedPiece.hpp"
+#include "SpscRing.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// What a ChangeRecord describes
+enum class ChangeKind : std::uint8_t {
+    Added = 0,      // piece was added
+    Removed = 1,    // piece was removed
+    Moved = 2,      // piece moved from (from_row, from_column) to its own row and column
+    Reset = 3       // every piece was dropped (eg. replaceAll or assignment); Added records follow
+};
+
+/**
+ * @brief One box mutation in 16 bytes. The piece is packed with its player index as its color.
+ *      PackedPiece only names PAWN and ROOK (see PackedPiece::fromPiece), so any other piece,
+ *      eg. a QUEEN or a PAWN whose size() is not 1, is published as type NONE with its own
+ *      position and direction; `size` always holds its real size(). A consumer that needs the
+ *      type of such a piece looks it up in the box.
+ */
+struct ChangeRecord {
+    std::uint32_t sequence;         // Per-feed counter; a gap means records were dropped
+    ChangeKind kind;
+    std::uint8_t player;            // Player index of the box that changed
+    PackedPiece piece;              // The piece (for Moved, where it ended up)
+    std::int8_t from_row;           // Moved only, else -1
+    std::int8_t from_column;        // Moved only, else -1
+    std::uint8_t size;              // The piece's size() (at most 255), 0 for Reset
+    std::uint8_t reserved;
+};
+
+static_assert(sizeof(ChangeRecord) == 16, "ChangeRecord is meant to stay compact");
+
+/**
+ * @brief A single-producer feed of ChangeRecords. The thread mutating the observed ChessBox
+ *      publishes; one consumer thread drains in batches. publish() never blocks or allocates:
+ *      when the ring is full the record is dropped and counted, and its sequence number is
+ *      still used, so the consumer can see the gap and resynchronize from the box.
+ */
+class ChangeFeed {
+    private:
+        SpscRing<ChangeRecord> ring_;               // Records waiting for the consumer
+        std::uint32_t next_sequence_;               // Producer only
+        std::atomic<std::uint64_t> published_;      // Records offered, written by the producer
+        std::atomic<std::uint64_t> dropped_;        // Records lost to a full ring
+
+    public:
+        /**
+         * @param capacity Records the ring holds before dropping (rounded up to a power of 2)
+         */
+        explicit ChangeFeed(std::size_t capacity = 4096);
+
+        ChangeFeed(const ChangeFeed&) = delete;
+        ChangeFeed& operator=(const ChangeFeed&) = delete;
+
+        /**
+         * @brief Offers a record, filling in its sequence number. Producer thread only.
+         * @return False if the ring was full and the record was dropped
+         */
+        bool publish(ChangeRecord record) {
+            record.sequence = next_sequence_++;
+            published_.store(published_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            if (ring_.tryPush(record)) {
+                return true;
+            }
+            dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        /**
+         * @brief Builds and publishes a record. Producer thread only.
+         * @param size The piece's size(), clamped to [0, 255]
+         */
+        bool publish(ChangeKind kind, int player, const PackedPiece& piece, int size,
+                     int from_row = -1, int from_column = -1);
+
+        /**
+         * @brief Moves up to `max` waiting records into out (appended). Consumer thread only.
+         * @return The number of records appended
+         */
+        std::size_t drain(std::vector<ChangeRecord>& out, std::size_t max = SIZE_MAX);
+
+        /**
+         * @return Records offered so far, including dropped ones
+         */
+        std::uint64_t published() const { return published_.load(std::memory_order_relaxed); }
+
+        /**
+         * @return Records dropped because the consumer fell behind
+         */
+        std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+        std::size_t capacity() const { return ring_.capacity(); }
+};
+
+#endif
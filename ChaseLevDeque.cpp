@@ -0,0 +1,104 @@
+// File: ChaseLevDeque.cpp
+// Date: 10/18/26
+// Implementation of the ChaseLevDeque template class
+
+#ifndef CHASE_LEV_DEQUE_CPP_
+#define CHASE_LEV_DEQUE_CPP_
+
+#include "ChaseLevDeque.hpp"
+
+template <typename T>
+ChaseLevDeque<T>::Array::Array(std::int64_t size) : capacity(size), items(new std::atomic<T>[size]) {
+}
+
+template <typename T>
+ChaseLevDeque<T>::Array::~Array() {
+    delete[] items;
+}
+
+template <typename T>
+ChaseLevDeque<T>::ChaseLevDeque(std::int64_t capacity) : top_(0), bottom_(0) {
+    std::int64_t size = 1;
+    while (size < capacity) {
+        size *= 2;
+    }
+    array_.store(new Array(size), std::memory_order_relaxed);
+}
+
+template <typename T>
+ChaseLevDeque<T>::~ChaseLevDeque() {
+    delete array_.load(std::memory_order_relaxed);
+    for (Array* array : retired_) {
+        delete array;
+    }
+}
+
+template <typename T>
+typename ChaseLevDeque<T>::Array* ChaseLevDeque<T>::grow(Array* array, std::int64_t top, std::int64_t bottom) {
+    Array* grown = new Array(array->capacity * 2);
+    for (std::int64_t i = top; i < bottom; i++) {
+        grown->put(i, array->get(i));
+    }
+    retired_.push_back(array);
+    array_.store(grown, std::memory_order_release);
+    return grown;
+}
+
+template <typename T>
+void ChaseLevDeque<T>::push(T item) {
+    std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    std::int64_t top = top_.load(std::memory_order_acquire);
+    Array* array = array_.load(std::memory_order_relaxed);
+    if (bottom - top > array->capacity - 1) {
+        array = grow(array, top, bottom);
+    }
+    array->put(bottom, item);
+    // Release: a thief that sees the new bottom also sees the item and everything it points to
+    bottom_.store(bottom + 1, std::memory_order_release);
+}
+
+template <typename T>
+bool ChaseLevDeque<T>::pop(T& item) {
+    // Claim the bottom item first, then see whether a thief got there too
+    std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Array* array = array_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t top = top_.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+        // Empty
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+    item = array->get(bottom);
+    if (top < bottom) {
+        return true;
+    }
+    // Last item: race the thieves for it
+    bool won = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return won;
+}
+
+template <typename T>
+bool ChaseLevDeque<T>::steal(T& item) {
+    std::int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) {
+        return false;
+    }
+    Array* array = array_.load(std::memory_order_acquire);
+    item = array->get(top);
+    return top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+}
+
+template <typename T>
+std::int64_t ChaseLevDeque<T>::size() const {
+    std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    std::int64_t top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? bottom - top : 0;
+}
+
+#endif
@@ -0,0 +1,78 @@
+// File: ChaseLevDeque.hpp
+// Date: 10/18/26
+// The Chase-Lev work-stealing deque: the owner pushes and pops at the bottom without
+// locks, other threads steal from the top with one compare-and-swap
+
+#ifndef CHASE_LEV_DEQUE_HPP_
+#define CHASE_LEV_DEQUE_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief A growable circular deque of trivially copyable items (eg. task pointers), following
+ *      Le, Pop, Cohen and Zappa Nardelli, "Correct and Efficient Work-Stealing for Weak Memory
+ *      Models" (PPoPP 2013). push() and pop() may only be called by the owning thread;
+ *      steal() and size() by any thread. Arrays outgrown by push() are kept until the deque
+ *      is destroyed, since a thief may still be reading one.
+ */
+template <typename T>
+class ChaseLevDeque {
+    static_assert(std::is_trivially_copyable<T>::value, "ChaseLevDeque items are copied racily");
+
+    private:
+        struct Array {
+            std::int64_t capacity;          // A power of two
+            std::atomic<T>* items;          // capacity slots, indexed modulo capacity
+
+            explicit Array(std::int64_t size);
+            ~Array();
+            T get(std::int64_t i) const { return items[i & (capacity - 1)].load(std::memory_order_relaxed); }
+            void put(std::int64_t i, T item) { items[i & (capacity - 1)].store(item, std::memory_order_relaxed); }
+        };
+
+        alignas(64) std::atomic<std::int64_t> top_;     // Next index to steal
+        alignas(64) std::atomic<std::int64_t> bottom_;  // Next index to push
+        std::atomic<Array*> array_;                     // Current array
+        std::vector<Array*> retired_;                   // Outgrown arrays (owner only)
+
+        // Doubles the array, copying the live items [top, bottom)
+        Array* grow(Array* array, std::int64_t top, std::int64_t bottom);
+
+    public:
+        /**
+         * @param capacity Initial capacity, rounded up to a power of two
+         */
+        explicit ChaseLevDeque(std::int64_t capacity = 256);
+        ~ChaseLevDeque();
+
+        ChaseLevDeque(const ChaseLevDeque&) = delete;
+        ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+        /**
+         * @brief Adds an item at the bottom. Owner only.
+         */
+        void push(T item);
+
+        /**
+         * @brief Takes the newest item. Owner only.
+         * @return False if the deque was empty (or a thief took the last item)
+         */
+        bool pop(T& item);
+
+        /**
+         * @brief Takes the oldest item. Any thread.
+         * @return False if the deque was empty or another thread won the race for the item
+         */
+        bool steal(T& item);
+
+        /**
+         * @return An estimate of the number of items, exact when no other thread is active
+         */
+        std::int64_t size() const;
+};
+
+#include "ChaseLevDeque.cpp"
+#endif // CHASE_LEV_DEQUE_HPP_
@@ -1,9 +1,18 @@
+// File: ChessBox.cpp
+// Date: 10/18/26
+// Implementation of the BasicChessBox template class
+
+#ifndef CHESS_BOX_CPP_
+#define CHESS_BOX_CPP_
+
 #include "ChessBox.hpp"
+#include "PackedPiece.hpp"
 #include <cctype>
 #include <algorithm>
+#include <thread>
 
 // Helper function to check if a string contains only alphabetic characters
-bool isAlphaString(const std::string& str) {
+inline bool isAlphaString(const std::string& str) {
     for (char c : str) {
         if (!isalpha(c)) {
             return false;
@@ -13,22 +22,79 @@ bool isAlphaString(const std::string& str) {
 }
 
 // Helper function to convert a string to uppercase
-std::string toUpperCase(const std::string& str) {
+inline std::string toUpperCase(const std::string& str) {
     std::string result = str;
     std::transform(result.begin(), result.end(), result.begin(), ::toupper);
     return result;
 }
 
+template <template <typename> class Storage>
+const char* const BasicChessBox<Storage>::DEFAULT_COLORS[MAX_PLAYERS] = {
+    "BLACK", "WHITE", "RED", "BLUE", "GREEN", "YELLOW", "ORANGE", "PURPLE"
+};
+
+// Builds the boxes and the color hash table; the colors are already validated
+template <template <typename> class Storage>
+BasicChessBox<Storage>::State::State(const std::vector<std::string>& player_colors, const std::vector<int>& capacities) :
+    colors(player_colors), free_entries(-1), occupancy{}, occupied(0), refs(1), stale_stats(~0u) {
+    boxes.reserve(colors.size());
+    std::fill(color_slots, color_slots + COLOR_SLOTS, 0);
+    std::fill(squares, squares + SQUARES, -1);
+    std::fill(tails, tails + SQUARES, -1);
+    for (std::size_t player = 0; player < colors.size(); player++) {
+        boxes.emplace_back(player < capacities.size() && capacities[player] > 0 ? capacities[player] : 64);
+        int slot = colorSlot(colors[player]);
+        while (color_slots[slot] != 0) {
+            slot = (slot + 1) & (COLOR_SLOTS - 1);
+        }
+        color_slots[slot] = static_cast<std::uint8_t>(player + 1);
+    }
+}
+
+template <template <typename> class Storage>
+BasicChessBox<Storage>::State::State(const State& other) :
+    colors(other.colors), boxes(other.boxes), types(other.types), entries(other.entries),
+    free_entries(other.free_entries), occupied(other.occupied), refs(1), stale_stats(~0u) {
+    {
+        // Another box sharing other may be refreshing its cache in stats() right now
+        std::lock_guard<std::mutex> lock(other.stats_mutex);
+        std::copy(other.stats, other.stats + MAX_PLAYERS, stats);
+        stale_stats.store(other.stale_stats.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    std::copy(other.color_slots, other.color_slots + COLOR_SLOTS, color_slots);
+    std::copy(other.squares, other.squares + SQUARES, squares);
+    std::copy(other.tails, other.tails + SQUARES, tails);
+    std::copy(other.occupancy, other.occupancy + MAX_PLAYERS, occupancy);
+}
+
+// Applies the color rules: uppercase alphabetic and distinct, or the default palette
+inline std::vector<std::string> validatedColors(const std::vector<std::string>& requested, int max_players,
+                                                const char* const* defaults) {
+    std::size_t count = std::min<std::size_t>(std::max<std::size_t>(requested.size(), 2), max_players);
+    std::vector<std::string> colors;
+    bool valid = requested.size() >= 2;
+    for (std::size_t player = 0; valid && player < count; player++) {
+        valid = isAlphaString(requested[player]);
+        colors.push_back(toUpperCase(requested[player]));
+        for (std::size_t before = 0; valid && before < player; before++) {
+            valid = colors[before] != colors[player];
+        }
+    }
+    if (!valid) {
+        colors.assign(defaults, defaults + count);
+    }
+    return colors;
+}
+
 /**
  * Default constructor
  * Default initializes P1_COLOR_ to "BLACK" and P2_COLOR_ to "WHITE"
- * Initializes LinkedBox members with capacity 64
+ * Initializes Box members with capacity 64
  */
-ChessBox::ChessBox() : 
-    P1_COLOR_("BLACK"), 
-    P2_COLOR_("WHITE"), 
-    P1_BOX_(), 
-    P2_BOX_() {
+template <template <typename> class Storage>
+BasicChessBox<Storage>::BasicChessBox() : 
+    state_(new State(std::vector<std::string>(DEFAULT_COLORS, DEFAULT_COLORS + 2), std::vector<int>())),
+    feed_(nullptr) {
 }
 
 /**
@@ -36,7 +102,7 @@ ChessBox::ChessBox() :
  * @param color1 A const reference to the color of the Chess Piece (a string)
  * @param color2 A const reference to the color of the Chess Piece (a string)
  * @param capacity An integer describing the 
- *                capacity of each player's LinkedBox, with default capacity 64.
+ *                capacity of each player's Box, with default capacity 64.
  * 
  * @note 1) If either color1 or color2 contains 
  *       non-alphabetic characters, set P1_COLOR_ to "BLACK" and P2_COLOR_ to "WHITE"
@@ -45,88 +111,155 @@ ChessBox::ChessBox() :
  *       3) However, if the are equal, set color1 to "BLACK" and color2 to "WHITE"
  *       4) If the specified capacity is not positive (ie. <= 0), 64 is used instead.
  * 
- * @post Initializes LinkedBox members with the specified capacity. 
+ * @post Initializes Box members with the specified capacity. 
  *       All strings are initialized as described above. 
  */
-ChessBox::ChessBox(const std::string& color1, const std::string& color2, int capacity) :
-    P1_BOX_(capacity <= 0 ? 64 : capacity),
-    P2_BOX_(capacity <= 0 ? 64 : capacity) {
-    
-    // Check if the colors are alphabetic
-    bool color1_alphabetic = isAlphaString(color1);
-    bool color2_alphabetic = isAlphaString(color2);
-    
-    // Set the colors
-    if (color1_alphabetic && color2_alphabetic) {
-        P1_COLOR_ = toUpperCase(color1);
-        P2_COLOR_ = toUpperCase(color2);
-        
-        // If the colors are equal, set to default
-        if (P1_COLOR_ == P2_COLOR_) {
-            P1_COLOR_ = "BLACK";
-            P2_COLOR_ = "WHITE";
+template <template <typename> class Storage>
+BasicChessBox<Storage>::BasicChessBox(const std::string& color1, const std::string& color2, int capacity) :
+    BasicChessBox(std::vector<std::string>{color1, color2}, capacity) {
+}
+
+template <template <typename> class Storage>
+BasicChessBox<Storage>::BasicChessBox(const std::vector<std::string>& colors, int capacity) :
+    BasicChessBox(colors, std::vector<int>(MAX_PLAYERS, capacity)) {
+}
+
+template <template <typename> class Storage>
+BasicChessBox<Storage>::BasicChessBox(const std::vector<std::string>& colors, const std::vector<int>& capacities) :
+    state_(new State(validatedColors(colors, MAX_PLAYERS, DEFAULT_COLORS), capacities)),
+    feed_(nullptr) {
+}
+
+template <template <typename> class Storage>
+int BasicChessBox<Storage>::playerOf(const std::string& color) const {
+    // Probe from the color's slot; a miss ends at the first empty slot
+    for (int slot = colorSlot(color); state_->color_slots[slot] != 0; slot = (slot + 1) & (COLOR_SLOTS - 1)) {
+        int player = state_->color_slots[slot] - 1;
+        if (state_->colors[player] == color) {
+            return player;
         }
-    } else {
-        P1_COLOR_ = "BLACK";
-        P2_COLOR_ = "WHITE";
     }
+    return -1;
+}
+
+// Copy constructor: share the State
+template <template <typename> class Storage>
+BasicChessBox<Storage>::BasicChessBox(const BasicChessBox& other) : state_(other.state_), feed_(nullptr) {
+    state_->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <template <typename> class Storage>
+BasicChessBox<Storage>& BasicChessBox<Storage>::operator=(const BasicChessBox& other) {
+    // Take the new reference first, so self-assignment cannot free the State
+    other.state_->refs.fetch_add(1, std::memory_order_relaxed);
+    release(state_);
+    state_ = other.state_;
+    publishAll();
+    return *this;
+}
+
+template <template <typename> class Storage>
+BasicChessBox<Storage>::~BasicChessBox() {
+    release(state_);
+}
+
+template <template <typename> class Storage>
+void BasicChessBox<Storage>::release(State* state) {
+    if (state->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete state;
+    }
+}
+
+template <template <typename> class Storage>
+typename BasicChessBox<Storage>::State& BasicChessBox<Storage>::mutableState() {
+    // The acquire pairs with release() in the other owners, so their reads of the
+    // State are finished before this one writes to it
+    if (state_->refs.load(std::memory_order_acquire) != 1) {
+        State* copy = new State(*state_);
+        release(state_);
+        state_ = copy;
+    }
+    return *state_;
 }
 
 // Getter for P1_COLOR
-std::string ChessBox::getP1Color() const {
-    return P1_COLOR_;
+template <template <typename> class Storage>
+std::string BasicChessBox<Storage>::getP1Color() const {
+    return state_->colors[0];
 }
 
 // Getter for P2_COLOR
-std::string ChessBox::getP2Color() const {
-    return P2_COLOR_;
+template <template <typename> class Storage>
+std::string BasicChessBox<Storage>::getP2Color() const {
+    return state_->colors[1];
 }
 
 /**
  * @brief Getter for P1_BOX
- * @return The LinkedBox<ChessPiece> (ie. the value) of P1_BOX_
+ * @return The PieceBox (ie. the value) of P1_BOX_
  */
-LinkedBox<ChessPiece> ChessBox::getP1Pieces() const {
-    return P1_BOX_;
+template <template <typename> class Storage>
+typename BasicChessBox<Storage>::PieceBox BasicChessBox<Storage>::getP1Pieces() const {
+    return state_->boxes[0];
 }
 
 /**
  * @brief Getter for P2_BOX
- * @return The LinkedBox<ChessPiece> (ie. the value) of P2_BOX_
+ * @return The PieceBox (ie. the value) of P2_BOX_
  */
-LinkedBox<ChessPiece> ChessBox::getP2Pieces() const {
-    return P2_BOX_;
+template <template <typename> class Storage>
+typename BasicChessBox<Storage>::PieceBox BasicChessBox<Storage>::getP2Pieces() const {
+    return state_->boxes[1];
+}
+
+// Non-copying view of P1_BOX_
+template <template <typename> class Storage>
+const typename BasicChessBox<Storage>::PieceBox& BasicChessBox<Storage>::viewP1Pieces() const {
+    return state_->boxes[0];
+}
+
+// Non-copying view of P2_BOX_
+template <template <typename> class Storage>
+const typename BasicChessBox<Storage>::PieceBox& BasicChessBox<Storage>::viewP2Pieces() const {
+    return state_->boxes[1];
 }
 
 /**
- * @brief Adds a given ChessPiece object to the LinkedBox corresponding to its color:
+ * @brief Adds a given ChessPiece object to the Box corresponding to its color:
  *      - If the color of the given piece matches P1_COLOR_, add it to P1_BOX_
  *      - If the color of the given piece matches P2_COLOR_, add it to P2_BOX_
  *      - If the color does not match either box, or the corresponding 
  *           box doesn't have enough remaining space to add the piece, 
  *           the add operation fails.
  * 
- * @param piece A const reference to a ChessPiece object that is to be added to one of the LinkedBoxes
+ * @param piece A const reference to a ChessPiece object that is to be added to one of the Boxes
  * @return True if the piece was added successfully. False otherwise.
  */
-bool ChessBox::addPiece(const ChessPiece& piece) {
-    // Get the color of the piece
-    std::string piece_color = piece.getColor();
-    
-    // Add to the appropriate box
-    if (piece_color == P1_COLOR_) {
-        return P1_BOX_.addItem(piece);
-    } else if (piece_color == P2_COLOR_) {
-        return P2_BOX_.addItem(piece);
-    }
-    
-    // If the color doesn't match either box
-    return false;
+template <template <typename> class Storage>
+bool BasicChessBox<Storage>::addPiece(const ChessPiece& piece) {
+    // Find the box of the piece's color
+    int player = playerOf(piece.getColor());
+    if (player == -1) {
+        return false;
+    }
+
+    // Add to it, copying shared pieces only when the add can succeed
+    const PieceBox& box = state_->boxes[player];
+    if (box.size() + piece.size() > box.capacity()) {
+        return false;
+    }
+    State& state = mutableState();
+    if (!state.boxes[player].addItem(piece)) {
+        return false;
+    }
+    indexPiece(state, player, piece);
+    publish(ChangeKind::Added, player, piece);
+    return true;
 }
 
 /**
  * @brief Removes a ChessPiece of the given type if one 
- *        exists in the LinkedBox corresponding to the given color
+ *        exists in the Box corresponding to the given color
  * 
  * @param type A const reference to an uppercase string 
  *             representing the type of the ChessPiece to remove
@@ -134,35 +267,511 @@ bool ChessBox::addPiece(const ChessPiece& piece) {
  *              representing the color of the ChessPiece to remove
  * @return True if a piece is found and removed. False otherwise. 
  */
-bool ChessBox::removePiece(const std::string& type, const std::string& color) {
-    // Remove from the appropriate box
-    if (color == P1_COLOR_) {
-        return P1_BOX_.remove(type);
-    } else if (color == P2_COLOR_) {
-        return P2_BOX_.remove(type);
-    }
-    
-    // If the color doesn't match either box
-    return false;
+template <template <typename> class Storage>
+bool BasicChessBox<Storage>::removePiece(const std::string& type, const std::string& color) {
+    // Remove from the appropriate box, copying shared pieces only when there is a match
+    int player = playerOf(color);
+    if (player == -1 || !state_->boxes[player].contains(type)) {
+        return false;
+    }
+    State& state = mutableState();
+    ChessPiece removed;
+    if (!state.boxes[player].remove(type, removed)) {
+        return false;
+    }
+    unindexPiece(state, player, removed);
+    publish(ChangeKind::Removed, player, removed);
+    return true;
 }
 
 /**
- * @brief Finds whether a ChessPiece of the given type exists within the LinkedBox corresponding to the given color
+ * @brief Finds whether a ChessPiece of the given type exists within the Box corresponding to the given color
  * 
  * @param type A const reference to an uppercase string 
  *             representing the type of the ChessPiece to find
  * @param color A const reference to an uppercase string 
  *             representing the color of the ChessPiece to find
- * @return True if a piece is contained within the correct LinkedBox. False otherwise. 
+ * @return True if a piece is contained within the correct Box. False otherwise. 
  */
-bool ChessBox::contains(const std::string& type, const std::string& color) const {
+template <template <typename> class Storage>
+bool BasicChessBox<Storage>::contains(const std::string& type, const std::string& color) const {
     // Check the appropriate box
-    if (color == P1_COLOR_) {
-        return P1_BOX_.contains(type);
-    } else if (color == P2_COLOR_) {
-        return P2_BOX_.contains(type);
+    int player = playerOf(color);
+    return player != -1 && state_->boxes[player].contains(type);
+}
+
+template <template <typename> class Storage>
+bool BasicChessBox<Storage>::planBatch(const ChessPiece* pieces, std::size_t count, bool replacing,
+                                       std::vector<int>& owner, std::vector<int>& order,
+                                       int (&starts)[MAX_PLAYERS + 1]) const {
+    int sizes[MAX_PLAYERS] = {};
+    int counts[MAX_PLAYERS] = {};
+    owner.resize(count);
+    for (std::size_t i = 0; i < count; i++) {
+        int player = playerOf(pieces[i].getColor());
+        if (player == -1) {
+            return false;
+        }
+        owner[i] = player;
+        sizes[player] += pieces[i].size();
+        counts[player]++;
+    }
+
+    starts[0] = 0;
+    for (int player = 0; player < MAX_PLAYERS; player++) {
+        if (player < playerCount()) {
+            const PieceBox& box = state_->boxes[player];
+            int size = replacing ? 0 : box.size();
+            int length = replacing ? 0 : box.length();
+            if (size + sizes[player] > box.capacity() || counts[player] > box.maxLength() - length) {
+                return false;
+            }
+        }
+        starts[player + 1] = starts[player] + counts[player];
+    }
+
+    // Counting sort by player keeps each player's pieces in their original order
+    int fill[MAX_PLAYERS];
+    std::copy(starts, starts + MAX_PLAYERS, fill);
+    order.resize(count);
+    for (std::size_t i = 0; i < count; i++) {
+        order[fill[owner[i]]++] = static_cast<int>(i);
+    }
+    return true;
+}
+
+template <template <typename> class Storage>
+void BasicChessBox<Storage>::applyBatch(State& state, const ChessPiece* pieces, std::size_t count,
+                                        const std::vector<int>& owner, const std::vector<int>& order,
+                                        const int (&starts)[MAX_PLAYERS + 1]) {
+    for (int player = 0; player < static_cast<int>(state.boxes.size()); player++) {
+        const int* group = order.data() + starts[player];
+        state.boxes[player].addItems(starts[player + 1] - starts[player],
+                                     [pieces, group](int i) -> const ChessPiece& { return pieces[group[i]]; });
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        indexPiece(state, owner[i], pieces[i]);
+    }
+}
+
+template <template <typename> class Storage>
+bool BasicChessBox<Storage>::addPieces(const ChessPiece* pieces, std::size_t count) {
+    std::vector<int> owner;
+    std::vector<int> order;
+    int starts[MAX_PLAYERS + 1];
+    if (!planBatch(pieces, count, false, owner, order, starts)) {
+        return false;
+    }
+    if (count > 0) {
+        applyBatch(mutableState(), pieces, count, owner, order, starts);
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        publish(ChangeKind::Added, owner[i], pieces[i]);
+    }
+    return true;
+}
+
+template <template <typename> class Storage>
+bool BasicChessBox<Storage>::removePieces(const std::vector<std::string>& types, const std::string& color) {
+    int player = playerOf(color);
+    int count = static_cast<int>(types.size());
+    if (player == -1 || !state_->boxes[player].hasItems(types.data(), count)) {
+        return false;
+    }
+    if (count == 0) {
+        return true;
+    }
+    State& state = mutableState();
+    std::vector<ChessPiece> removed(types.size());
+    state.boxes[player].removeItems(types.data(), count, removed.data());
+    for (const ChessPiece& piece : removed) {
+        unindexPiece(state, player, piece);
+        publish(ChangeKind::Removed, player, piece);
+    }
+    return true;
+}
+
+template <template <typename> class Storage>
+bool BasicChessBox<Storage>::replaceAll(const ChessPiece* pieces, std::size_t count) {
+    std::vector<int> owner;
+    std::vector<int> order;
+    int starts[MAX_PLAYERS + 1];
+    if (!planBatch(pieces, count, true, owner, order, starts)) {
+        return false;
+    }
+
+    // A shared State is left to its other owners rather than copied and then emptied
+    if (state_->refs.load(std::memory_order_acquire) != 1) {
+        std::vector<int> capacities;
+        for (const PieceBox& box : state_->boxes) {
+            capacities.push_back(box.capacity());
+        }
+        State* fresh = new State(state_->colors, capacities);
+        release(state_);
+        state_ = fresh;
+    } else {
+        for (PieceBox& box : state_->boxes) {
+            box.clear();
+        }
+        clearIndex(*state_);
+        state_->stale_stats.store(~0u, std::memory_order_relaxed);
+    }
+    applyBatch(*state_, pieces, count, owner, order, starts);
+    publishAll();
+    return true;
+}
+
+template <template <typename> class Storage>
+void BasicChessBox<Storage>::publishAll() const {
+    if (feed_ == nullptr) {
+        return;
+    }
+    feed_->publish(ChangeKind::Reset, 0, PackedPiece(), 0);
+    for (int player = 0; player < playerCount(); player++) {
+        state_->boxes[player].forEach([this, player](const ChessPiece& piece) {
+            publish(ChangeKind::Added, player, piece);
+        });
+    }
+}
+
+// Whether a piece is on the board, ie. has a mailbox square
+inline bool isOnBoard(int row, int col) {
+    return row >= 0 && row < PackedPiece::BOARD_LENGTH && col >= 0 && col < PackedPiece::BOARD_LENGTH;
+}
+
+template <template <typename> class Storage>
+typename BasicChessBox<Storage>::SquareEntry BasicChessBox<Storage>::entryOf(State& state, int player, const ChessPiece& piece) {
+    std::string type = piece.getType();
+    std::size_t index = std::find(state.types.begin(), state.types.end(), type) - state.types.begin();
+    if (index == state.types.size()) {
+        state.types.push_back(type);
+    }
+    return SquareEntry{piece.size(), static_cast<std::uint16_t>(index), static_cast<std::uint8_t>(player),
+                       piece.isMovingUp(), -1};
+}
+
+template <template <typename> class Storage>
+void BasicChessBox<Storage>::clearIndex(State& state) {
+    state.entries.clear();
+    state.free_entries = -1;
+    std::fill(state.squares, state.squares + SQUARES, -1);
+    std::fill(state.tails, state.tails + SQUARES, -1);
+    std::fill(state.occupancy, state.occupancy + MAX_PLAYERS, 0);
+    state.occupied = 0;
+}
+
+template <template <typename> class Storage>
+void BasicChessBox<Storage>::indexPiece(State& state, int player, const ChessPiece& piece) {
+    state.stale_stats.fetch_or(1u << player, std::memory_order_relaxed);
+    if (!isOnBoard(piece.getRow(), piece.getColumn())) {
+        return;
+    }
+    int square = piece.getRow() * BOARD_LENGTH + piece.getColumn();
+    std::int32_t index = state.free_entries;
+    if (index >= 0) {
+        state.free_entries = state.entries[index].next;
+        state.entries[index] = entryOf(state, player, piece);
+    } else {
+        index = static_cast<std::int32_t>(state.entries.size());
+        state.entries.push_back(entryOf(state, player, piece));
+    }
+    // Append, so the chain stays oldest first
+    std::int32_t tail = state.tails[square];
+    (tail >= 0 ? state.entries[tail].next : state.squares[square]) = index;
+    state.tails[square] = index;
+    state.occupancy[player] |= std::uint64_t(1) << square;
+    state.occupied |= std::uint64_t(1) << square;
+}
+
+template <template <typename> class Storage>
+void BasicChessBox<Storage>::unindexPiece(State& state, int player, const ChessPiece& piece) {
+    state.stale_stats.fetch_or(1u << player, std::memory_order_relaxed);
+    if (!isOnBoard(piece.getRow(), piece.getColumn())) {
+        return;
+    }
+    // Entries equal to the piece's are interchangeable; drop the oldest
+    int square = piece.getRow() * BOARD_LENGTH + piece.getColumn();
+    SquareEntry target = entryOf(state, player, piece);
+    bool player_left = false;
+    bool erased = false;
+    std::int32_t previous = -1;
+    for (std::int32_t* link = &state.squares[square]; *link >= 0; ) {
+        SquareEntry& entry = state.entries[*link];
+        if (!erased && entry == target) {
+            // Unchain it onto the free chain
+            std::int32_t index = *link;
+            *link = entry.next;
+            if (state.tails[square] == index) {
+                state.tails[square] = previous;
+            }
+            entry.next = state.free_entries;
+            state.free_entries = index;
+            erased = true;
+            continue;
+        }
+        player_left = player_left || entry.player == player;
+        previous = *link;
+        link = &entry.next;
+    }
+    if (!player_left) {
+        state.occupancy[player] &= ~(std::uint64_t(1) << square);
+    }
+    if (state.squares[square] < 0) {
+        state.occupied &= ~(std::uint64_t(1) << square);
+    }
+}
+
+template <template <typename> class Storage>
+void BasicChessBox<Storage>::collect(std::uint64_t mask, std::vector<ChessPiece>& out) const {
+    mask &= state_->occupied;
+    while (mask != 0) {
+        int square = __builtin_ctzll(mask);
+        mask &= mask - 1;
+        for (std::int32_t index = state_->squares[square]; index >= 0; index = state_->entries[index].next) {
+            out.push_back(pieceOf(state_->entries[index], square));
+        }
+    }
+}
+
+template <template <typename> class Storage>
+bool BasicChessBox<Storage>::movePiece(int from_row, int from_col, int to_row, int to_col) {
+    if (!isOnBoard(from_row, from_col) || !isOnBoard(to_row, to_col)) {
+        return false;
+    }
+    int from_square = from_row * BOARD_LENGTH + from_col;
+    if (state_->squares[from_square] < 0) {
+        return false;
+    }
+    const SquareEntry entry = state_->entries[state_->squares[from_square]];
+    ChessPiece piece = pieceOf(entry, from_square);
+    int player = entry.player;
+    State& state = mutableState();
+
+    // Pieces matching the same index entry on the same square are interchangeable,
+    // so moving the first such item of the box matches the index
+    ChessPiece* stored = state.boxes[player].findIf([&piece](const ChessPiece& item) {
+        return item.getRow() == piece.getRow() && item.getColumn() == piece.getColumn() &&
+               item.getType() == piece.getType() && item.isMovingUp() == piece.isMovingUp() &&
+               item.size() == piece.size();
+    });
+    if (stored == nullptr) {
+        return false;
+    }
+    unindexPiece(state, player, piece);
+    stored->setRow(to_row);
+    stored->setColumn(to_col);
+    indexPiece(state, player, *stored);
+    publish(ChangeKind::Moved, player, *stored, from_row, from_col);
+    return true;
+}
+
+template <template <typename> class Storage>
+const PlayerStats& BasicChessBox<Storage>::stats(int player) const {
+    static const PlayerStats NONE;
+    if (player < 0 || player >= playerCount()) {
+        return NONE;
+    }
+    State& state = *state_;
+    unsigned bit = 1u << player;
+    if (state.stale_stats.load(std::memory_order_acquire) & bit) {
+        std::lock_guard<std::mutex> lock(state.stats_mutex);
+        if (state.stale_stats.load(std::memory_order_relaxed) & bit) {
+            const PieceBox& box = state.boxes[player];
+            PlayerStats fresh;
+            fresh.size = box.size();
+            fresh.capacity = box.capacity();
+            box.forEach([&fresh](const ChessPiece& piece) {
+                std::string type = piece.getType();
+                if (type == "PAWN") {
+                    fresh.pawns++;
+                    int last_row = piece.isMovingUp() ? BOARD_LENGTH - 1 : 0;
+                    int distance = piece.isMovingUp() ? last_row - piece.getRow() : piece.getRow();
+                    if (piece.getRow() >= 0 && distance <= 1) {
+                        fresh.pawns_near_promotion++;
+                    }
+                } else if (type == "ROOK") {
+                    fresh.rooks++;
+                } else {
+                    fresh.others++;
+                }
+            });
+            state.stats[player] = fresh;
+            state.stale_stats.fetch_and(~bit, std::memory_order_release);
+        }
+    }
+    return state.stats[player];
+}
+
+template <template <typename> class Storage>
+bool BasicChessBox<Storage>::pieceAt(int row, int col, ChessPiece& piece) const {
+    if (!isOnBoard(row, col)) {
+        return false;
+    }
+    int square = row * BOARD_LENGTH + col;
+    if (state_->squares[square] < 0) {
+        return false;
+    }
+    piece = pieceOf(state_->entries[state_->squares[square]], square);
+    return true;
+}
+
+template <template <typename> class Storage>
+std::vector<ChessPiece> BasicChessBox<Storage>::piecesInRow(int row) const {
+    std::vector<ChessPiece> pieces;
+    if (row >= 0 && row < BOARD_LENGTH) {
+        collect(std::uint64_t(0xFF) << (row * BOARD_LENGTH), pieces);
+    }
+    return pieces;
+}
+
+template <template <typename> class Storage>
+std::vector<ChessPiece> BasicChessBox<Storage>::piecesInColumn(int col) const {
+    std::vector<ChessPiece> pieces;
+    if (col >= 0 && col < BOARD_LENGTH) {
+        collect(std::uint64_t(0x0101010101010101) << col, pieces);
+    }
+    return pieces;
+}
+
+template <template <typename> class Storage>
+std::vector<ChessPiece> BasicChessBox<Storage>::piecesInRect(int row1, int col1, int row2, int col2) const {
+    std::vector<ChessPiece> pieces;
+    int low_row = std::max(std::min(row1, row2), 0);
+    int high_row = std::min(std::max(row1, row2), BOARD_LENGTH - 1);
+    int low_col = std::max(std::min(col1, col2), 0);
+    int high_col = std::min(std::max(col1, col2), BOARD_LENGTH - 1);
+    if (low_row > high_row || low_col > high_col) {
+        return pieces;
+    }
+    std::uint64_t row_bits = ((std::uint64_t(1) << (high_col - low_col + 1)) - 1) << low_col;
+    std::uint64_t mask = 0;
+    for (int row = low_row; row <= high_row; row++) {
+        mask |= row_bits << (row * BOARD_LENGTH);
+    }
+    collect(mask, pieces);
+    return pieces;
+}
+
+template <template <typename> class Storage>
+bool BasicChessBox<Storage>::firstPieceAlongRay(int row, int col, int row_step, int col_step, ChessPiece& piece) const {
+    if (row_step == 0 && col_step == 0) {
+        return false;
+    }
+    std::uint64_t occupied = state_->occupied;
+    for (row += row_step, col += col_step; isOnBoard(row, col); row += row_step, col += col_step) {
+        int square = row * BOARD_LENGTH + col;
+        if (occupied & (std::uint64_t(1) << square)) {
+            piece = pieceOf(state_->entries[state_->squares[square]], square);
+            return true;
+        }
     }
-    
-    // If the color doesn't match either box
     return false;
-}
\ No newline at end of file
+}
+
+// Appends the castle pairs of one player's box, bucketing its pieces by square
+template <typename PieceBox>
+void appendCastlePairs(const PieceBox& box, int player, std::vector<CastlePair>& pairs) {
+    const int length = PackedPiece::BOARD_LENGTH;
+    const int squares = length * length;
+
+    // Square of each piece (-1 off the board) and which ones are rooks, in forEach order
+    std::vector<int> square_of;
+    std::vector<int> rooks;
+    square_of.reserve(box.length());
+    box.forEach([&](const ChessPiece& piece) {
+        bool on_board = isOnBoard(piece.getRow(), piece.getColumn());
+        if (piece.getType() == "ROOK" && on_board) {
+            rooks.push_back(static_cast<int>(square_of.size()));
+        }
+        square_of.push_back(on_board ? piece.getRow() * length + piece.getColumn() : -1);
+    });
+    if (rooks.empty()) {
+        return;
+    }
+
+    // Counting sort by square; indexes stay ascending within a square
+    std::vector<int> start(squares + 1, 0);
+    for (int square : square_of) {
+        if (square >= 0) {
+            start[square + 1]++;
+        }
+    }
+    for (int square = 0; square < squares; square++) {
+        start[square + 1] += start[square];
+    }
+    std::vector<int> by_square(start[squares]);
+    std::vector<int> fill(start.begin(), start.end() - 1);
+    for (int i = 0; i < static_cast<int>(square_of.size()); i++) {
+        if (square_of[i] >= 0) {
+            by_square[fill[square_of[i]]++] = i;
+        }
+    }
+
+    // Default-constructed Rooks have 3 castle moves, so only the position rule can fail here
+    std::vector<int> partners;
+    for (int rook : rooks) {
+        int row = square_of[rook] / length;
+        int col = square_of[rook] % length;
+        partners.clear();
+        for (int c = std::max(col - 1, 0); c <= std::min(col + 1, length - 1); c++) {
+            int square = row * length + c;
+            partners.insert(partners.end(), by_square.begin() + start[square], by_square.begin() + start[square + 1]);
+        }
+        std::sort(partners.begin(), partners.end());
+        for (int piece : partners) {
+            if (piece != rook) {
+                pairs.push_back(CastlePair{player, rook, piece});
+            }
+        }
+    }
+}
+
+template <template <typename> class Storage>
+std::vector<CastlePair> BasicChessBox<Storage>::castlePairs() const {
+    std::vector<CastlePair> pairs;
+    for (int player = 0; player < playerCount(); player++) {
+        appendCastlePairs(state_->boxes[player], player, pairs);
+    }
+    return pairs;
+}
+
+template <template <typename> class Storage>
+std::vector<std::vector<CastlePair>> castlePairs(const std::vector<BasicChessBox<Storage>>& boxes, Scheduler& scheduler) {
+    std::vector<std::vector<CastlePair>> pairs(boxes.size());
+    scheduler.parallelFor(0, boxes.size(), 64, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            pairs[i] = boxes[i].castlePairs();
+        }
+    });
+    return pairs;
+}
+
+template <template <typename> class Storage>
+bool checkConcurrentStats(int rounds) {
+    const int length = BasicChessBox<Storage>::BOARD_LENGTH;
+    BasicChessBox<Storage> reader("BLACK", "WHITE");
+    bool consistent = true;
+    for (int round = 0; round < rounds && consistent; round++) {
+        // Leave player 0 stale in the shared State, so the reader rescans while the writer copies it
+        int pawns = round % length + 1;
+        std::vector<ChessPiece> pieces;
+        for (int col = 0; col < pawns; col++) {
+            pieces.push_back(ChessPiece("BLACK", length - 2, col, false, 1, "PAWN"));
+        }
+        reader.replaceAll(pieces);
+        BasicChessBox<Storage> writer(reader);
+
+        PlayerStats read;
+        std::thread reading([&reader, &read] { read = reader.stats(0); });
+        writer.addPiece(ChessPiece("BLACK", -1, -1, false, 1, "PAWN"));
+        reading.join();
+
+        const PlayerStats& written = writer.stats(0);
+        consistent = read.pawns == pawns && read.size == pawns &&
+                     written.pawns == pawns + 1 && written.size == pawns + 1;
+    }
+    // Player indices out of range read as empty instead of indexing past the boxes
+    return consistent && reader.stats(-1).capacity == 0 && reader.stats(reader.playerCount()).capacity == 0;
+}
+
+#endif // CHESS_BOX_CPP_
@@ -1,36 +1,179 @@
 // File: ChessBox.hpp
 // Author: Stefan Leonardo
 // Date: 2/14/25
-// Definition of the ChessBox class now using LinkedBox containers
+// Definition of the ChessBox class, templated on the Box storage policy
 
 #ifndef CHESS_BOX_HPP_
 #define CHESS_BOX_HPP_
 
-#include "LinkedBox.hpp"
+#include "Box.hpp"
+#include "ChangeFeed.hpp"
 #include "ChessPiece.hpp"
+#include "Scheduler.hpp"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
 #include <string>
+#include <vector>
+
+/**
+ * @brief Aggregates of one player's box, as returned by BasicChessBox::stats()
+ */
+struct PlayerStats {
+    int pawns = 0;                  // PAWN pieces
+    int rooks = 0;                  // ROOK pieces
+    int others = 0;                 // Pieces of any other type
+    int size = 0;                   // Total size of the pieces (the material)
+    int capacity = 0;               // Capacity of the box
+    int pawns_near_promotion = 0;   // Pawns on the board at most one row from their last row
+};
+
+/**
+ * @brief A (rook, piece) pair that Rook::canCastle() accepts, as indices into one player's box
+ *      in its forEach order
+ */
+struct CastlePair {
+    int player;     // Player index (0 for Player 1, 1 for Player 2, ...)
+    int rook;       // Index of the ROOK
+    int piece;      // Index of the piece it can castle with (never the rook itself)
+
+    bool operator==(const CastlePair& other) const {
+        return player == other.player && rook == other.rook && piece == other.piece;
+    }
+};
+
+/**
+ * @brief Holds the pieces of 2 to MAX_PLAYERS players, one Box per player.
+ *      The Storage policy picks the layout of every box; `ChessBox` is the LinkedStorage
+ *      instantiation, matching the original class.
+ *      Copies are copy-on-write: the colors, boxes and index live in one reference-counted
+ *      State that a write copies only while it is shared.
+ *      A per-square index of the pieces on the board makes pieceAt O(1) and the piecesIn...
+ *      queries O(k) in the pieces found. Pieces off the board are kept in the boxes only.
+ *      Every mutation can be published to a ChangeFeed (see setChangeFeed()).
+ */
+template <template <typename> class Storage = LinkedStorage>
+class BasicChessBox {
+    public:
+        typedef Box<ChessPiece, Storage> PieceBox;
+
+        static const int BOARD_LENGTH = 8;
+        static const int SQUARES = BOARD_LENGTH * BOARD_LENGTH;
+        static const int MAX_PLAYERS = 8;
+        static const int COLOR_SLOTS = 32;  // Color hash table size, a power of 2 above MAX_PLAYERS
 
-class ChessBox {
     private:
-        std::string P1_COLOR_;               // Color for Player 1
-        std::string P2_COLOR_;               // Color for Player 2
-        LinkedBox<ChessPiece> P1_BOX_;       // Box for Player 1's pieces
-        LinkedBox<ChessPiece> P2_BOX_;       // Box for Player 2's pieces
-        
+        // A piece in the square index: every ChessPiece field but the square it is indexed under
+        struct SquareEntry {
+            std::int32_t size;      // size()
+            std::uint16_t type;     // getType(), as an index into State::types
+            std::uint8_t player;    // getColor(), as a player index
+            bool moving_up;         // isMovingUp()
+            std::int32_t next;      // Next entry on the same square (or in the free chain), -1 at the end
+
+            // Compares the piece fields, not the chain
+            bool operator==(const SquareEntry& other) const {
+                return size == other.size && type == other.type && player == other.player && moving_up == other.moving_up;
+            }
+        };
+
+        struct State {
+            std::vector<std::string> colors;            // Uppercase color of each player
+            std::uint8_t color_slots[COLOR_SLOTS];      // Color hash table: player + 1, 0 when empty
+            std::vector<PieceBox> boxes;                // One box per player, contiguous
+            std::vector<std::string> types;             // Piece types seen by the index, in first-seen order
+            std::vector<SquareEntry> entries;           // Pool of index entries, chained per square
+            std::int32_t squares[SQUARES];              // First (oldest) entry on each square (row * 8 + column), or -1
+            std::int32_t tails[SQUARES];                // Last (newest) entry on each square, or -1
+            std::int32_t free_entries;                  // First unused entry of the pool, or -1
+            std::uint64_t occupancy[MAX_PLAYERS];       // Per player: bit row * 8 + column set where it has a piece
+            std::uint64_t occupied;                     // Union of the occupancy masks
+            std::atomic<int> refs;                      // ChessBoxes sharing this State
+            mutable PlayerStats stats[MAX_PLAYERS];     // Cached per-player aggregates
+            mutable std::atomic<unsigned> stale_stats;  // Bit per player whose stats need a rescan
+            mutable std::mutex stats_mutex;             // Serializes rescans by readers sharing the State
+
+            // One box per color, of capacities[player] (64 where missing or not positive)
+            State(const std::vector<std::string>& player_colors, const std::vector<int>& capacities);
+            State(const State& other);
+        };
+
+        State* state_;                      // Shared with copies until one of them writes
+        ChangeFeed* feed_;                  // Receives this ChessBox's mutations, or nullptr
+
+        // Color hash table slot to start probing at
+        static int colorSlot(const std::string& color) {
+            return (static_cast<unsigned char>(color.empty() ? 0 : color[0]) * 7 +
+                    static_cast<int>(color.size())) & (COLOR_SLOTS - 1);
+        }
+
+        static void release(State* state);
+
+        // Gives this ChessBox its own State before a write, copying it if it is shared
+        State& mutableState();
+
+        // Spatial index upkeep for a piece of the given player added to / removed from its box
+        // (they also mark the player's cached stats stale)
+        static void indexPiece(State& state, int player, const ChessPiece& piece);
+        static void unindexPiece(State& state, int player, const ChessPiece& piece);
+
+        // The index entry for a piece of the given player, adding its type to state.types if new
+        static SquareEntry entryOf(State& state, int player, const ChessPiece& piece);
+
+        // Unchains every entry of the index
+        static void clearIndex(State& state);
+
+        // Rebuilds the piece an index entry on the given square stands for
+        ChessPiece pieceOf(const SquareEntry& entry, int square) const {
+            return ChessPiece(state_->colors[entry.player], square / BOARD_LENGTH, square % BOARD_LENGTH,
+                              entry.moving_up, entry.size, state_->types[entry.type]);
+        }
+
+        // Routes pieces to players and checks the boxes can take them (on top of their current
+        // pieces unless replacing). Fills owner[i] and the order of the pieces grouped by player.
+        bool planBatch(const ChessPiece* pieces, std::size_t count, bool replacing,
+                       std::vector<int>& owner, std::vector<int>& order, int (&starts)[MAX_PLAYERS + 1]) const;
+
+        // Adds planned pieces to a State this ChessBox owns
+        static void applyBatch(State& state, const ChessPiece* pieces, std::size_t count,
+                               const std::vector<int>& owner, const std::vector<int>& order,
+                               const int (&starts)[MAX_PLAYERS + 1]);
+
+        // Publishes a mutation if a feed is attached. Pieces PackedPiece cannot name go out as
+        // type NONE with their position, direction and size (see ChangeRecord).
+        void publish(ChangeKind kind, int player, const ChessPiece& piece, int from_row = -1, int from_col = -1) const {
+            if (feed_ != nullptr) {
+                PackedPiece packed(PieceType::None, player, piece.getRow(), piece.getColumn(), piece.isMovingUp());
+                PackedPiece::fromPiece(piece, player, packed);
+                feed_->publish(kind, player, packed, piece.size(), from_row, from_col);
+            }
+        }
+
+        // Publishes a Reset followed by every piece as Added
+        void publishAll() const;
+
+        // Appends the pieces on the squares set in mask, in square order
+        void collect(std::uint64_t mask, std::vector<ChessPiece>& out) const;
+
     public:
+        /**
+         * @brief The colors used when the requested ones are invalid, in player order
+         */
+        static const char* const DEFAULT_COLORS[MAX_PLAYERS];
+
         /**
          * Default constructor
          * Default initializes P1_COLOR_ to "BLACK" and P2_COLOR_ to "WHITE"
-         * Initializes LinkedBox members with capacity 64
+         * Initializes Box members with capacity 64
          */
-        ChessBox();
+        BasicChessBox();
 
         /**
          * Paramaterized Constructor
          * @param color1 A const reference to the color of the Chess Piece (a string)
          * @param color2 A const reference to the color of the Chess Piece (a string)
          * @param capacity An integer describing the 
-         *                 capacity of each player's LinkedBox, with default capacity 64.
+         *                 capacity of each player's Box, with default capacity 64.
          * 
          * @note 1) If either color1 or color2 contains 
          *       non-alphabetic characters, set P1_COLOR_ to "BLACK" and P2_COLOR_ to "WHITE"
@@ -39,10 +182,78 @@ class ChessBox {
          *       3) However, if the are equal, set color1 to "BLACK" and color2 to "WHITE"
          *       4) If the specified capacity is not positive (ie. <= 0), 64 is used instead.
          * 
-         * @post Initializes LinkedBox members with the specified capacity. 
+         * @post Initializes Box members with the specified capacity. 
          *       All strings are initialized as described above. 
          */
-        ChessBox(const std::string& color1, const std::string& color2, int capacity = 64);
+        BasicChessBox(const std::string& color1, const std::string& color2, int capacity = 64);
+
+        /**
+         * @brief N-player constructor: one player per color, in order
+         * @param colors Between 2 and MAX_PLAYERS colors; any past MAX_PLAYERS are ignored
+         * @param capacity The capacity of each player's Box (64 if not positive)
+         * @note As with two players, colors are stored in uppercase. If fewer than 2 colors are
+         *      given, any color is not alphabetic, or two colors are equal, the first colors of
+         *      DEFAULT_COLORS are used instead.
+         */
+        BasicChessBox(const std::vector<std::string>& colors, int capacity = 64);
+
+        /**
+         * @brief N-player constructor with a capacity per player, eg. to restore a saved box
+         * @param colors As for the constructor above
+         * @param capacities The capacity of each player's Box, in player order
+         *      (64 for players without one or with a capacity that is not positive)
+         */
+        BasicChessBox(const std::vector<std::string>& colors, const std::vector<int>& capacities);
+
+        /**
+         * @brief Copy constructor: shares the pieces with `other` until either one writes. O(1).
+         *      The copy has no change feed.
+         */
+        BasicChessBox(const BasicChessBox& other);
+        /**
+         * @brief Takes the pieces of `other` (shared until either one writes). This box keeps its
+         *      own change feed, which receives a Reset and the new pieces.
+         */
+        BasicChessBox& operator=(const BasicChessBox& other);
+        ~BasicChessBox();
+
+        /**
+         * @brief Attaches a feed that receives a record for every mutation of this ChessBox:
+         *      Added/Removed per piece, Moved for movePiece, and Reset before replaceAll's pieces.
+         *      Records carry every piece's position, direction and size, but only PAWN and ROOK
+         *      keep their type; other pieces arrive as type NONE (see ChangeRecord).
+         *      The thread that mutates the box is the feed's producer. The feed must outlive the
+         *      attachment; pass nullptr to detach. Publishing never blocks (see ChangeFeed).
+         */
+        void setChangeFeed(ChangeFeed* feed) { feed_ = feed; }
+        ChangeFeed* changeFeed() const { return feed_; }
+
+        /**
+         * @return True if another ChessBox currently shares this one's pieces
+         */
+        bool isShared() const { return state_->refs.load(std::memory_order_acquire) > 1; }
+
+        /**
+         * @return The number of players
+         */
+        int playerCount() const { return static_cast<int>(state_->colors.size()); }
+
+        /**
+         * @return The player index of a color, or -1 if no player has it. O(1).
+         */
+        int playerOf(const std::string& color) const;
+
+        /**
+         * @return The color of the given player
+         * @pre 0 <= player < playerCount()
+         */
+        const std::string& getColor(int player) const { return state_->colors[player]; }
+
+        /**
+         * @return A const reference to the given player's box (see viewP1Pieces)
+         * @pre 0 <= player < playerCount()
+         */
+        const PieceBox& viewPieces(int player) const { return state_->boxes[player]; }
 
         /**
          * @brief Getter for P1_Color
@@ -58,32 +269,47 @@ class ChessBox {
 
         /**
          * @brief Getter for P1_BOX
-         * @return The LinkedBox<ChessPiece> (ie. the value) of P1_BOX_
+         * @return The PieceBox (ie. the value) of P1_BOX_
          */
-        LinkedBox<ChessPiece> getP1Pieces() const;
+        PieceBox getP1Pieces() const;
 
         /**
          * @brief Getter for P2_BOX
-         * @return The LinkedBox<ChessPiece> (ie. the value) of P2_BOX_
+         * @return The PieceBox (ie. the value) of P2_BOX_
          */
-        LinkedBox<ChessPiece> getP2Pieces() const;
+        PieceBox getP2Pieces() const;
 
         /**
-         * @brief Adds a given ChessPiece object to the LinkedBox corresponding to its color:
+         * @brief Read-only access to P1_BOX_ without copying it
+         * @return A const reference to P1_BOX_, valid while this ChessBox is alive and unmodified
+         *      (a write may move this ChessBox onto a private copy)
+         */
+        const PieceBox& viewP1Pieces() const;
+
+        /**
+         * @brief Read-only access to P2_BOX_ without copying it
+         * @return A const reference to P2_BOX_, valid while this ChessBox is alive and unmodified
+         *      (a write may move this ChessBox onto a private copy)
+         */
+        const PieceBox& viewP2Pieces() const;
+
+        /**
+         * @brief Adds a given ChessPiece object to the Box corresponding to its color:
          *      - If the color of the given piece matches P1_COLOR_, add it to P1_BOX_
          *      - If the color of the given piece matches P2_COLOR_, add it to P2_BOX_
+         *      - and so on for the other players
          *      - If the color does not match either box, or the corresponding 
          *           box doesn't have enough remaining space to add the piece, 
          *           the add operation fails.
          * 
-         * @param piece A const reference to a ChessPiece object that is to be added to one of the LinkedBoxes
+         * @param piece A const reference to a ChessPiece object that is to be added to one of the Boxes
          * @return True if the piece was added successfully. False otherwise.
          */
         bool addPiece(const ChessPiece& piece);
 
         /**
          * @brief Removes a ChessPiece of the given type if one 
-         *        exists in the LinkedBox corresponding to the given color
+         *        exists in the Box corresponding to the given color
          * 
          * @param type A const reference to an uppercase string 
          *             representing the type of the ChessPiece to remove
@@ -94,15 +320,129 @@ class ChessBox {
         bool removePiece(const std::string& type, const std::string& color);
 
         /**
-         * @brief Finds whether a ChessPiece of the given type exists within the LinkedBox corresponding to the given color
+         * @brief Finds whether a ChessPiece of the given type exists within the Box corresponding to the given color
          * 
          * @param type A const reference to an uppercase string 
          *             representing the type of the ChessPiece to find
          * @param color A const reference to an uppercase string 
          *             representing the color of the ChessPiece to find
-         * @return True if a piece is contained within the correct LinkedBox. False otherwise. 
+         * @return True if a piece is contained within the correct Box. False otherwise. 
          */
         bool contains(const std::string& type, const std::string& color) const;
+
+        /**
+         * @brief Moves the piece at (from_row, from_col) to (to_row, to_col). If several pieces share
+         *      the square, the oldest moves. The destination may already hold pieces (nothing is captured).
+         * @return True if a piece was moved. False if the source square is empty or either square
+         *      is off the board.
+         */
+        bool movePiece(int from_row, int from_col, int to_row, int to_col);
+
+        /**
+         * @brief Adds every piece or none. Each piece is routed to its color's box and the boxes'
+         *      capacities are checked once up front; then each box receives its pieces in one pass,
+         *      in order, as addPiece() on each piece would.
+         * @param pieces The pieces to add, count of them
+         * @return True if every piece was added. False if any color is unknown or any box would
+         *      overflow (the ChessBox is unchanged).
+         */
+        bool addPieces(const ChessPiece* pieces, std::size_t count);
+        bool addPieces(const std::vector<ChessPiece>& pieces) { return addPieces(pieces.data(), pieces.size()); }
+
+        /**
+         * @brief Removes one piece of the given color per entry of types (repeat a type to remove
+         *      several), all or none, as removePiece() on each entry would
+         * @return True if every piece was found and removed. False otherwise (the ChessBox is unchanged).
+         */
+        bool removePieces(const std::vector<std::string>& types, const std::string& color);
+
+        /**
+         * @brief Replaces every player's pieces with the given ones, all or none
+         * @return True if every piece has a known color and each box can hold its pieces.
+         *      False otherwise (the ChessBox keeps its old pieces).
+         */
+        bool replaceAll(const ChessPiece* pieces, std::size_t count);
+        bool replaceAll(const std::vector<ChessPiece>& pieces) { return replaceAll(pieces.data(), pieces.size()); }
+
+        /**
+         * @brief Finds every pair that Rook::canCastle() accepts, in one pass per box: the pieces
+         *      on the board are bucketed by row and column (each box holds a single color), and each
+         *      ROOK is paired with the other pieces in its own and the two neighbouring columns.
+         *      The box stores ChessPieces, so each ROOK counts as a Rook with its default 3 castle moves.
+         * @return The pairs ordered by player, then rook index, then piece index: the same pairs,
+         *      in the same order, as calling canCastle on every (rook, other piece) of each box
+         */
+        std::vector<CastlePair> castlePairs() const;
+
+        /**
+         * @brief Aggregates of one player's box, kept lazily: every write marks the player's
+         *      entry stale and the next read rescans that player's box once. Reads with no
+         *      write in between are O(1). Safe to call from threads sharing a copy of this box.
+         * @param player 0 for Player 1, 1 for Player 2, ...
+         * @return The player's stats, valid until the next write to this ChessBox.
+         *      All zero for a player index out of range.
+         * @pre 0 <= player < playerCount()
+         */
+        const PlayerStats& stats(int player) const;
+
+        /**
+         * @brief Occupancy bitmask of one player: bit row * BOARD_LENGTH + column is set where
+         *      the player has at least one piece
+         * @param player 0 for Player 1, 1 for Player 2, ...
+         */
+        std::uint64_t occupancy(int player) const { return state_->occupancy[player]; }
+
+        /**
+         * @brief Finds the piece at (row, col). If several share the square, the oldest is returned.
+         * @param piece Receives the piece if there is one
+         * @return True if a piece is on the square. False if it is empty or off the board.
+         */
+        bool pieceAt(int row, int col, ChessPiece& piece) const;
+
+        /**
+         * @return The pieces of both players in the row, by column (empty for an invalid row)
+         */
+        std::vector<ChessPiece> piecesInRow(int row) const;
+
+        /**
+         * @return The pieces of both players in the column, by row (empty for an invalid column)
+         */
+        std::vector<ChessPiece> piecesInColumn(int col) const;
+
+        /**
+         * @return The pieces of both players in the rectangle between the two corners (inclusive,
+         *      in any order, clipped to the board), by row then column
+         */
+        std::vector<ChessPiece> piecesInRect(int row1, int col1, int row2, int col2) const;
+
+        /**
+         * @brief Walks from (row, col), not included, in steps of (row_step, col_step) and stops at
+         *      the first occupied square, eg. (0, 1) looks right along the row and (1, 1) diagonally
+         * @param piece Receives the first piece found (the oldest one on that square)
+         * @return True if a piece was found before leaving the board. False otherwise, including
+         *      for a (0, 0) step.
+         */
+        bool firstPieceAlongRay(int row, int col, int row_step, int col_step, ChessPiece& piece) const;
 };
 
+/**
+ * @brief castlePairs() for many boxes at once, split over the scheduler's workers
+ * @return The pairs of boxes[i] in element i
+ */
+template <template <typename> class Storage>
+std::vector<std::vector<CastlePair>> castlePairs(const std::vector<BasicChessBox<Storage>>& boxes, Scheduler& scheduler);
+
+/**
+ * @brief Concurrency check for stats(): each round, one thread reads stats(0) of a box while
+ *      another thread's write to a copy of it detaches the shared pieces and their cached stats.
+ *      Meant to be run under ThreadSanitizer as well.
+ * @return True if every round saw the stats of both boxes it expected
+ */
+template <template <typename> class Storage>
+bool checkConcurrentStats(int rounds = 1000);
+
+// The original two-player box backed by linked storage
+typedef BasicChessBox<LinkedStorage> ChessBox;
+
+#include "ChessBox.cpp"
 #endif // CHESS_BOX_HPP_
\ No newline at end of file
@@ -0,0 +1,108 @@
+// File: ChessBoxSnapshot.cpp
+// Date: 10/18/26
+// Implementation of the snapshot checksum and SnapshotView
+
+#include "ChessBoxSnapshot.hpp"
+
+std::uint32_t snapshotChecksum(const char* data, std::size_t bytes) {
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < bytes; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+SnapshotView::SnapshotView() :
+    data_(nullptr),
+    players_(nullptr),
+    pieces_(nullptr),
+    bytes_(0) {
+    std::memset(&header_, 0, sizeof(header_));
+}
+
+bool SnapshotView::open(const void* data, std::size_t bytes, bool verify_checksum) {
+    *this = SnapshotView();
+
+    const char* base = static_cast<const char*>(data);
+    if (!base || bytes < sizeof(SnapshotHeader)) {
+        return false;
+    }
+
+    // The header and player records may sit at any alignment, so they are copied out;
+    // the pieces are byte-aligned and are used in place
+    SnapshotHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, "CBXS", 4) != 0 || header.version != SNAPSHOT_VERSION) {
+        return false;
+    }
+
+    std::size_t total = sizeof(SnapshotHeader) +
+                        header.player_count * sizeof(SnapshotPlayer) +
+                        static_cast<std::size_t>(header.piece_count) * sizeof(PackedPiece);
+    if (total > bytes) {
+        return false;
+    }
+
+    // The per-player counts must add up to the total
+    const char* players = base + sizeof(SnapshotHeader);
+    std::size_t counted = 0;
+    for (int player = 0; player < header.player_count; player++) {
+        SnapshotPlayer record;
+        std::memcpy(&record, players + player * sizeof(SnapshotPlayer), sizeof(record));
+        counted += record.piece_count;
+    }
+    if (counted != header.piece_count) {
+        return false;
+    }
+
+    if (verify_checksum &&
+        snapshotChecksum(players, total - sizeof(SnapshotHeader)) != header.checksum) {
+        return false;
+    }
+
+    data_ = base;
+    header_ = header;
+    players_ = players;
+    pieces_ = reinterpret_cast<const PackedPiece*>(players + header.player_count * sizeof(SnapshotPlayer));
+    bytes_ = total;
+    return true;
+}
+
+SnapshotPlayer SnapshotView::player(int player) const {
+    SnapshotPlayer record;
+    std::memcpy(&record, players_ + player * sizeof(SnapshotPlayer), sizeof(record));
+    return record;
+}
+
+std::size_t SnapshotView::bytes() const {
+    return bytes_;
+}
+
+int SnapshotView::playerCount() const {
+    return data_ ? header_.player_count : 0;
+}
+
+std::string SnapshotView::color(int player) const {
+    SnapshotPlayer record = this->player(player);
+    const void* end = std::memchr(record.color, '\0', sizeof(record.color));
+    std::size_t length = end ? static_cast<const char*>(end) - record.color : sizeof(record.color);
+    return std::string(record.color, length);
+}
+
+int SnapshotView::capacity(int player) const {
+    return this->player(player).capacity;
+}
+
+int SnapshotView::pieceCount(int player) const {
+    return static_cast<int>(this->player(player).piece_count);
+}
+
+const PackedPiece* SnapshotView::pieces(int player) const {
+    // Skip the pieces of the players before this one
+    const PackedPiece* pieces = pieces_;
+    for (int before = 0; before < player; before++) {
+        pieces += this->player(before).piece_count;
+    }
+    return pieces;
+}
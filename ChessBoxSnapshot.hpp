@@ -0,0 +1,248 @@
+// File: ChessBoxSnapshot.hpp
+// Date: 10/18/26
+// A versioned, checksummed binary snapshot format for ChessBox, and a
+// zero-copy view for reading snapshots straight out of a buffer or mapping
+
+#ifndef CHESS_BOX_SNAPSHOT_HPP_
+#define CHESS_BOX_SNAPSHOT_HPP_
+
+#include "ChessBox.hpp"
+#include "PackedPiece.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * Snapshot layout (little-endian, no padding, every field at a fixed offset):
+ *      [SnapshotHeader][SnapshotPlayer x player_count][PackedPiece x piece_count]
+ * The pieces are grouped by player in player order, so each player's pieces are
+ * one contiguous PackedPiece array that can be used in place.
+ */
+struct SnapshotHeader {
+    char magic[4];                  // "CBXS"
+    std::uint16_t version;          // SNAPSHOT_VERSION
+    std::uint16_t player_count;     // Number of SnapshotPlayer records
+    std::uint32_t piece_count;      // Total number of pieces
+    std::uint32_t checksum;         // FNV-1a over every byte after the header
+};
+
+struct SnapshotPlayer {
+    char color[24];                 // Uppercase color, NUL padded
+    std::int32_t capacity;          // Capacity of the player's box
+    std::uint32_t piece_count;      // Number of pieces for this player
+};
+
+static_assert(sizeof(SnapshotHeader) == 16, "SnapshotHeader is an on-disk layout");
+static_assert(sizeof(SnapshotPlayer) == 32, "SnapshotPlayer is an on-disk layout");
+
+const std::uint16_t SNAPSHOT_VERSION = 1;
+const std::size_t SNAPSHOT_MAX_COLOR = sizeof(SnapshotPlayer::color) - 1;
+
+/**
+ * @brief FNV-1a hash of a byte range, used as the snapshot checksum
+ */
+std::uint32_t snapshotChecksum(const char* data, std::size_t bytes);
+
+/**
+ * @brief A read-only view of a snapshot held in memory (a buffer, a mapped file, ...).
+ *      open() only validates the header and checksum; the pieces are read in place,
+ *      never parsed or copied. The view does not own the bytes, which must outlive it.
+ */
+class SnapshotView {
+    private:
+        const char* data_;                  // Start of the snapshot, nullptr while empty
+        SnapshotHeader header_;             // Copy of the header at data_
+        const char* players_;               // Player records following the header
+        const PackedPiece* pieces_;         // All pieces, grouped by player
+        std::size_t bytes_;                 // Total snapshot length
+
+        // Copies out the record of the given player (records may be unaligned)
+        SnapshotPlayer player(int player) const;
+
+    public:
+        /**
+         * @brief Default constructor. The view is empty until open() succeeds.
+         */
+        SnapshotView();
+
+        /**
+         * @brief Points the view at a snapshot
+         * @param data The first byte of the snapshot
+         * @param bytes The number of bytes available at data
+         * @param verify_checksum False to skip the checksum pass when the bytes are already trusted
+         * @return True if the bytes hold a complete, valid snapshot. False otherwise (the view is left empty).
+         */
+        bool open(const void* data, std::size_t bytes, bool verify_checksum = true);
+
+        /**
+         * @return The number of bytes the snapshot occupies (0 if the view is empty)
+         */
+        std::size_t bytes() const;
+
+        /**
+         * @return The number of players in the snapshot (0 if the view is empty)
+         */
+        int playerCount() const;
+
+        /**
+         * @return The color of the given player
+         */
+        std::string color(int player) const;
+
+        /**
+         * @return The box capacity of the given player
+         */
+        int capacity(int player) const;
+
+        /**
+         * @return The number of pieces the given player has
+         */
+        int pieceCount(int player) const;
+
+        /**
+         * @return The given player's pieces, pieceCount(player) of them, in place in the snapshot
+         */
+        const PackedPiece* pieces(int player) const;
+};
+
+/**
+ * @brief Appends a snapshot of every player of `box` to `out`.
+ *      ChessBox stores pieces as plain ChessPiece values, so the Pawn/Rook specific
+ *      fields are written with their defaults (see PackedPiece::fromPiece).
+ * @return False if a color is longer than SNAPSHOT_MAX_COLOR characters or a piece cannot be
+ *      packed (any type but PAWN or ROOK, or an unusual size); out is then left unchanged
+ */
+template <template <typename> class Storage>
+bool writeSnapshot(const BasicChessBox<Storage>& box, std::vector<char>& out) {
+    int player_count = box.playerCount();
+    std::size_t piece_count = 0;
+    for (int player = 0; player < player_count; player++) {
+        if (box.getColor(player).size() > SNAPSHOT_MAX_COLOR) {
+            return false;
+        }
+        piece_count += box.viewPieces(player).length();
+    }
+
+    std::size_t start = out.size();
+    out.resize(start + sizeof(SnapshotHeader) + player_count * sizeof(SnapshotPlayer) + piece_count * sizeof(PackedPiece));
+    char* base = out.data() + start;
+
+    SnapshotHeader header;
+    std::memcpy(header.magic, "CBXS", 4);
+    header.version = SNAPSHOT_VERSION;
+    header.player_count = static_cast<std::uint16_t>(player_count);
+    header.piece_count = static_cast<std::uint32_t>(piece_count);
+
+    // Player records, then each player's pieces packed straight into place
+    char* cursor = base + sizeof(SnapshotHeader);
+    PackedPiece* pieces = reinterpret_cast<PackedPiece*>(cursor + player_count * sizeof(SnapshotPlayer));
+    bool packed = true;
+    for (int player = 0; player < player_count; player++) {
+        const typename BasicChessBox<Storage>::PieceBox& player_box = box.viewPieces(player);
+        const std::string& color = box.getColor(player);
+        SnapshotPlayer record;
+        std::memset(&record, 0, sizeof(record));
+        std::memcpy(record.color, color.data(), color.size());
+        record.capacity = player_box.capacity();
+        record.piece_count = static_cast<std::uint32_t>(player_box.length());
+        std::memcpy(cursor, &record, sizeof(record));
+        cursor += sizeof(record);
+
+        player_box.forEach([&](const ChessPiece& piece) {
+            packed = PackedPiece::fromPiece(piece, player, *pieces++) && packed;
+        });
+    }
+    if (!packed) {
+        out.resize(start);
+        return false;
+    }
+
+    header.checksum = snapshotChecksum(base + sizeof(SnapshotHeader), out.size() - start - sizeof(SnapshotHeader));
+    std::memcpy(base, &header, sizeof(header));
+    return true;
+}
+
+// Stands in for a piece while working out where a storage policy puts the items it is given
+struct SlotProbe {
+    int index;      // Position of the item in the batch
+    int size() const { return 1; }
+    std::string getType() const { return std::string(); }
+};
+
+/**
+ * @brief Works out the order to add `count` items to an empty Box<T, Storage> in, so that its
+ *      forEach() visits them as items 0, 1, ..., count - 1 (eg. a LinkedStorage box needs them
+ *      last first). Policies place items by their position in a batch, never by value, so a dry
+ *      run with SlotProbes gives the answer for any policy.
+ * @param order Receives count indices: item order[0] is added first, then order[1], ...
+ * @return False if the policy cannot hold count items
+ */
+template <template <typename> class Storage>
+bool insertionOrder(int count, std::vector<int>& order) {
+    Box<SlotProbe, Storage> probe(count);
+    if (!probe.addItems(count, [](int i) { return SlotProbe{i}; })) {
+        return false;
+    }
+    // The probe added at batch position p is visited at step j, so item j must go in at p
+    order.assign(count, 0);
+    int step = 0;
+    probe.forEach([&order, &step](const SlotProbe& item) { order[item.index] = step++; });
+    return true;
+}
+
+/**
+ * @brief Rebuilds a box from a snapshot view: colors, every player's capacity and the pieces,
+ *      which each player's box then visits in the order they were written (its forEach order)
+ * @param view An open view with 2 to MAX_PLAYERS players
+ * @param box Receives the restored box
+ * @return False (and box is left unchanged) if the view is empty, has an unsupported number of
+ *      players, holds colors or capacities a box would not keep as they are, holds a piece of
+ *      type NONE, or holds more pieces than a player's capacity or storage allows
+ */
+template <template <typename> class Storage>
+bool readSnapshot(const SnapshotView& view, BasicChessBox<Storage>& box) {
+    int player_count = view.playerCount();
+    if (player_count < 2 || player_count > BasicChessBox<Storage>::MAX_PLAYERS) {
+        return false;
+    }
+
+    std::vector<std::string> colors;
+    std::vector<int> capacities;
+    for (int player = 0; player < player_count; player++) {
+        colors.push_back(view.color(player));
+        capacities.push_back(view.capacity(player));
+    }
+    BasicChessBox<Storage> restored(colors, capacities);
+    for (int player = 0; player < player_count; player++) {
+        if (restored.getColor(player) != colors[player] || restored.viewPieces(player).capacity() != capacities[player]) {
+            return false;
+        }
+    }
+
+    // replaceAll() keeps each player's pieces in the order given, which insertionOrder() picks
+    std::vector<ChessPiece> pieces;
+    std::vector<int> order;
+    for (int player = 0; player < player_count; player++) {
+        const PackedPiece* packed = view.pieces(player);
+        int count = view.pieceCount(player);
+        if (!insertionOrder<Storage>(count, order)) {
+            return false;
+        }
+        for (int i = 0; i < count; i++) {
+            const PackedPiece& piece = packed[order[i]];
+            if (piece.type() == PieceType::None) {
+                return false;
+            }
+            pieces.push_back(piece.toChessPiece(colors[player]));
+        }
+    }
+    if (!restored.replaceAll(pieces)) {
+        return false;
+    }
+    box = restored;
+    return true;
+}
+
+#endif // CHESS_BOX_SNAPSHOT_HPP_
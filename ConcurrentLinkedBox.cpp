@@ -0,0 +1,204 @@
+// File: ConcurrentLinkedBox.cpp
+// Date: 10/18/26
+// Implementation of the ConcurrentLinkedBox template class
+
+#ifndef CONCURRENT_LINKED_BOX_CPP_
+#define CONCURRENT_LINKED_BOX_CPP_
+
+#include "ConcurrentLinkedBox.hpp"
+#include "LinkedBox.hpp"
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
+template <typename T>
+ConcurrentLinkedBox<T>::ConcurrentLinkedBox() : size_(0), capacity_(64), head_(nullptr), epoch_(0) {
+}
+
+template <typename T>
+ConcurrentLinkedBox<T>::ConcurrentLinkedBox(const int& capacity) : size_(0), head_(nullptr), epoch_(0) {
+    capacity_ = (capacity <= 0) ? 64 : capacity;
+}
+
+template <typename T>
+int ConcurrentLinkedBox<T>::readerStripe() {
+    static thread_local const int stripe =
+        static_cast<int>(std::hash<std::thread::id>()(std::this_thread::get_id()) % READER_STRIPES);
+    return stripe;
+}
+
+template <typename T>
+int ConcurrentLinkedBox<T>::enterRead() const {
+    int stripe = readerStripe();
+    for (;;) {
+        unsigned long epoch = epoch_.load(std::memory_order_seq_cst);
+        int parity = static_cast<int>(epoch & 1);
+        readers_[parity][stripe].count.fetch_add(1, std::memory_order_seq_cst);
+        // If a remover flipped the epoch in between, it may already have seen this count as zero
+        if (epoch_.load(std::memory_order_seq_cst) == epoch) {
+            return parity;
+        }
+        readers_[parity][stripe].count.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+template <typename T>
+void ConcurrentLinkedBox<T>::exitRead(int parity) const {
+    readers_[parity][readerStripe()].count.fetch_sub(1, std::memory_order_release);
+}
+
+template <typename T>
+void ConcurrentLinkedBox<T>::synchronize() {
+    // New readers register under the new parity and start from head_, after the unlink,
+    // so only readers counted under the old parity can still reach the removed node.
+    // Removers are serialized, so the old parity's earlier readers were already drained.
+    int parity = static_cast<int>(epoch_.fetch_add(1, std::memory_order_seq_cst) & 1);
+    for (int stripe = 0; stripe < READER_STRIPES; stripe++) {
+        while (readers_[parity][stripe].count.load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+template <typename T>
+bool ConcurrentLinkedBox<T>::addItem(const T& target) {
+    // Reserve the item's size first, so the capacity can never be overshot
+    int item_size = target.size();
+    int current = size_.load(std::memory_order_relaxed);
+    do {
+        if (current + item_size > capacity_) {
+            return false;
+        }
+    } while (!size_.compare_exchange_weak(current, current + item_size, std::memory_order_acq_rel));
+
+    Node* node = new Node(target, head_.load(std::memory_order_relaxed));
+    Node* expected = node->next.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(expected, node, std::memory_order_release, std::memory_order_relaxed)) {
+        node->next.store(expected, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+template <typename T>
+bool ConcurrentLinkedBox<T>::remove(const std::string& type) {
+    std::lock_guard<std::mutex> lock(remove_mutex_);
+
+    // Only removers change next pointers of linked nodes, and they hold the lock, but
+    // producers keep pushing onto head_, so unlinking the head needs a compare-and-swap
+    Node* victim = nullptr;
+    for (;;) {
+        std::atomic<Node*>* link = &head_;
+        Node* current = head_.load(std::memory_order_acquire);
+        while (current != nullptr && current->value.getType() != type) {
+            link = &current->next;
+            current = current->next.load(std::memory_order_acquire);
+        }
+        if (current == nullptr) {
+            return false;
+        }
+
+        Node* next = current->next.load(std::memory_order_relaxed);
+        if (link != &head_) {
+            link->store(next, std::memory_order_release);
+        } else if (!head_.compare_exchange_strong(current, next, std::memory_order_release,
+                                                  std::memory_order_relaxed)) {
+            // A new head was pushed; the newest matching item may now be a different one
+            continue;
+        }
+        victim = current;
+        break;
+    }
+
+    size_.fetch_sub(victim->value.size(), std::memory_order_acq_rel);
+    synchronize();
+    delete victim;
+    return true;
+}
+
+template <typename T>
+bool ConcurrentLinkedBox<T>::contains(const std::string& type) const {
+    int parity = enterRead();
+    bool found = false;
+    for (Node* current = head_.load(std::memory_order_acquire); current != nullptr;
+         current = current->next.load(std::memory_order_acquire)) {
+        if (current->value.getType() == type) {
+            found = true;
+            break;
+        }
+    }
+    exitRead(parity);
+    return found;
+}
+
+template <typename T>
+int ConcurrentLinkedBox<T>::count(const std::string& type) const {
+    int parity = enterRead();
+    int count = 0;
+    for (Node* current = head_.load(std::memory_order_acquire); current != nullptr;
+         current = current->next.load(std::memory_order_acquire)) {
+        if (current->value.getType() == type) {
+            count++;
+        }
+    }
+    exitRead(parity);
+    return count;
+}
+
+template <typename T>
+ConcurrentLinkedBox<T>::~ConcurrentLinkedBox() {
+    Node* current = head_.load(std::memory_order_relaxed);
+    while (current != nullptr) {
+        Node* next = current->next.load(std::memory_order_relaxed);
+        delete current;
+        current = next;
+    }
+}
+
+template <typename T>
+ContentionBenchmark benchmarkConcurrentBox(const T& item, int threads, int adds) {
+    using Clock = std::chrono::steady_clock;
+    ContentionBenchmark result;
+    result.threads = threads < 1 ? 1 : threads;
+    adds = adds < 1 ? 1 : adds;
+    std::string type = item.getType();
+    int capacity = result.threads * adds * (item.size() > 0 ? item.size() : 1);
+    double operations = static_cast<double>(result.threads) * (adds + adds / 4);
+
+    auto run = [&result](const std::function<void()>& work) {
+        std::vector<std::thread> workers;
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < result.threads; i++) {
+            workers.emplace_back(work);
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    };
+
+    ConcurrentLinkedBox<T> concurrent(capacity);
+    result.concurrent_ns = run([&] {
+        for (int i = 0; i < adds; i++) {
+            concurrent.addItem(item);
+            if (i % 4 == 3) {
+                concurrent.contains(type);
+            }
+        }
+    }) / operations;
+
+    LinkedBox<T> locked(capacity);
+    std::mutex mutex;
+    result.locked_ns = run([&] {
+        for (int i = 0; i < adds; i++) {
+            std::lock_guard<std::mutex> lock(mutex);
+            locked.addItem(item);
+            if (i % 4 == 3) {
+                locked.contains(type);
+            }
+        }
+    }) / operations;
+    return result;
+}
+
+#endif
@@ -0,0 +1,131 @@
+// File: ConcurrentLinkedBox.hpp
+// Date: 10/18/26
+// A LinkedBox that many threads can use at once: lock-free insertion at the head,
+// lock-free readers, and epoch-based reclamation for removed nodes
+
+#ifndef CONCURRENT_LINKED_BOX_HPP_
+#define CONCURRENT_LINKED_BOX_HPP_
+
+#include <atomic>
+#include <mutex>
+#include <string>
+
+/**
+ * @brief Same interface and behaviour as LinkedBox (items are inserted at the head and size
+ *      counts item sizes against the capacity), safe to call from any number of threads:
+ *      - addItem reserves its size with a compare-and-swap on size_, then pushes its node onto
+ *        head_ with another (a Treiber stack), so producers never lock or wait for each other
+ *      - contains and count walk the chain without locks
+ *      - remove is serialized by a mutex. After unlinking its node it waits for every reader
+ *        that might still hold it (a grace period) and then frees it, so readers never touch
+ *        freed memory and never wait themselves.
+ *      Readers announce themselves in one of two reader counts chosen by the epoch's parity;
+ *      a remover flips the epoch and waits for the old parity's count to drain. The counts
+ *      are striped over cache lines so readers on different threads rarely share one.
+ */
+template <typename T>
+class ConcurrentLinkedBox {
+    public:
+        static const int READER_STRIPES = 16;
+
+    private:
+        struct Node {
+            T value;                    // The stored item
+            std::atomic<Node*> next;    // Next (older) node
+
+            Node(const T& item, Node* next_node) : value(item), next(next_node) {}
+        };
+
+        struct alignas(64) ReaderCount {
+            std::atomic<long> count{0};
+        };
+
+        std::atomic<int> size_;                         // Reserved size, including adds in progress
+        int capacity_;                                  // Maximum capacity
+        std::atomic<Node*> head_;                       // Newest node
+        std::mutex remove_mutex_;                       // Serializes removers
+        std::atomic<unsigned long> epoch_;              // Parity selects the reader counts in use
+        mutable ReaderCount readers_[2][READER_STRIPES];    // Active readers per parity and stripe
+
+        // Stripe for the calling thread
+        static int readerStripe();
+
+        // Registers a reader; returns the parity it registered under
+        int enterRead() const;
+        void exitRead(int parity) const;
+
+        // Waits until no reader that started before the call is still active (remover only)
+        void synchronize();
+
+    public:
+        /**
+         * @brief Default constructor
+         * @post An empty box with capacity 64
+         */
+        ConcurrentLinkedBox();
+
+        /**
+         * @brief Parameterized constructor
+         * @param capacity The capacity of the box
+         * @note If the capacity is 0 or negative, 64 is used instead
+         */
+        ConcurrentLinkedBox(const int& capacity);
+
+        ConcurrentLinkedBox(const ConcurrentLinkedBox&) = delete;
+        ConcurrentLinkedBox& operator=(const ConcurrentLinkedBox&) = delete;
+
+        /**
+         * @return The size of the items added or being added
+         */
+        int size() const { return size_.load(std::memory_order_acquire); }
+
+        int capacity() const { return capacity_; }
+
+        /**
+         * @brief Inserts an item at the head if its size fits in the remaining capacity. Lock-free.
+         * @return True if the add was successful. False otherwise.
+         */
+        bool addItem(const T& target);
+
+        /**
+         * @brief Removes the first (newest) item of the given type and frees its node once no
+         *      reader can be looking at it
+         * @return True if an item was removed. False otherwise.
+         */
+        bool remove(const std::string& type);
+
+        /**
+         * @return True if an item of the given type is in the box. Lock-free.
+         */
+        bool contains(const std::string& type) const;
+
+        /**
+         * @return The number of items of the given type. Lock-free; concurrent adds and removes
+         *      may or may not be counted.
+         */
+        int count(const std::string& type) const;
+
+        /**
+         * @brief Destructor: frees every node. No other thread may be using the box.
+         */
+        ~ConcurrentLinkedBox();
+};
+
+/**
+ * @brief Results of benchmarkConcurrentBox(), in nanoseconds per operation across all threads
+ */
+struct ContentionBenchmark {
+    int threads = 0;
+    double concurrent_ns = 0;   // ConcurrentLinkedBox
+    double locked_ns = 0;       // LinkedBox behind one std::mutex
+};
+
+/**
+ * @brief Contention benchmark: each thread adds `adds` copies of the item and runs a contains()
+ *      after every fourth add, on one shared ConcurrentLinkedBox and then on one mutex-wrapped LinkedBox
+ */
+template <typename T>
+ContentionBenchmark benchmarkConcurrentBox(const T& item, int threads, int adds);
+
+#include "ConcurrentLinkedBox.cpp"
+#endif // CONCURRENT_LINKED_BOX_HPP_
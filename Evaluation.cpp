@@ -0,0 +1,74 @@
+// File: Evaluation.cpp
+// Date: 10/18/26
+// Implementation of the static evaluation functions
+
+#include "Evaluation.hpp"
+#include "Board.hpp"
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+std::int32_t evaluate(const Board& board) {
+    std::int32_t score = 0;
+    for (int square = 0; square < Board::SQUARES; square++) {
+        score += squareScore(board.at(square), square);
+    }
+    return score;
+}
+
+#ifdef __AVX2__
+// Reads a board's squares straight from PackedPiece's fixed 6-byte layout
+// (type, color, row, column, flags with bit 0 moving up, castle moves), 8 pieces per step
+static std::int32_t evaluateAvx2(const Board& board) {
+    const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(&board.at(0));
+    // 8 pieces are 12 words. The first 4 come from words 0-7, the last 4 from words 4-11.
+    // Piece k's type and color sit in the low or high half of word (3k) / 2, its flags in word (3k + 2) / 2.
+    const __m256i head_low = _mm256_setr_epi32(0, 1, 3, 4, 0, 0, 0, 0);
+    const __m256i head_high = _mm256_setr_epi32(0, 0, 0, 0, 2, 3, 5, 6);
+    const __m256i flags_low = _mm256_setr_epi32(1, 2, 4, 5, 0, 0, 0, 0);
+    const __m256i flags_high = _mm256_setr_epi32(0, 0, 0, 0, 3, 4, 6, 7);
+    const __m256i halves = _mm256_setr_epi32(0, 16, 0, 16, 0, 16, 0, 16);
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i byte_mask = _mm256_set1_epi32(0xFF);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i scored = _mm256_set1_epi32(SCORED_PLAYER);
+
+    __m256i sum = _mm256_setzero_si256();
+    for (int square = 0; square < Board::SQUARES; square += 8) {
+        const std::uint8_t* pieces = bytes + square * sizeof(PackedPiece);
+        __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pieces));
+        __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pieces + 16));
+
+        __m256i head = _mm256_blend_epi32(_mm256_permutevar8x32_epi32(low, head_low),
+                                          _mm256_permutevar8x32_epi32(high, head_high), 0xF0);
+        __m256i flags = _mm256_blend_epi32(_mm256_permutevar8x32_epi32(low, flags_low),
+                                           _mm256_permutevar8x32_epi32(high, flags_high), 0xF0);
+        head = _mm256_srlv_epi32(head, halves);
+        flags = _mm256_srlv_epi32(flags, halves);
+
+        __m256i type = _mm256_and_si256(head, byte_mask);
+        __m256i color = _mm256_and_si256(_mm256_srli_epi32(head, 8), byte_mask);
+        __m256i up = _mm256_and_si256(flags, one);
+        __m256i key = _mm256_add_epi32(_mm256_slli_epi32(type, 2), _mm256_slli_epi32(up, 1));
+        key = _mm256_sub_epi32(key, _mm256_cmpeq_epi32(color, scored));
+
+        __m256i index = _mm256_add_epi32(_mm256_slli_epi32(key, 6), _mm256_add_epi32(_mm256_set1_epi32(square), lanes));
+        sum = _mm256_add_epi32(sum, _mm256_i32gather_epi32(SQUARE_SCORES.values, index, 4));
+    }
+
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(half);
+}
+#endif
+
+void evaluateBatch(const Board* boards, std::size_t count, std::int32_t* scores) {
+    for (std::size_t i = 0; i < count; i++) {
+#ifdef __AVX2__
+        scores[i] = evaluateAvx2(boards[i]);
+#else
+        scores[i] = evaluate(boards[i]);
+#endif
+    }
+}
@@ -0,0 +1,129 @@
+// File: Evaluation.hpp
+// Date: 10/18/26
+// Static evaluation: material plus piece-square tables, per square and per batch of boards,
+// and the Zobrist keys that identify a board's pawn structure
+
+#ifndef EVALUATION_HPP
+#define EVALUATION_HPP
+
+#include "PackedPiece.hpp"
+#include <cstddef>
+#include <cstdint>
+
+class Board;
+
+// Scores are from this player's point of view (Board::WHITE_PLAYER): its pieces count
+// positive, every other player's negative
+const int SCORED_PLAYER = 1;
+
+// Material per unit of size(): a PAWN (size 1) is worth 100, a ROOK (size 2) 200
+const int MATERIAL_PER_SIZE = 100;
+
+/**
+ * @brief Material plus piece-square bonus for every kind of piece on every square, signed for
+ *      SCORED_PLAYER. Rows are keyed by scoreKey(); the piece-square tables are written from a
+ *      piece's own side of the board, so a piece moving down reads them with its row mirrored.
+ *      Built at compile time, so boards constructed during static initialization can use it.
+ */
+struct SquareScores {
+    static const int KEYS = 12;     // 3 PieceTypes x moving up or down x scored player or not
+
+    std::int32_t values[KEYS * PackedPiece::BOARD_LENGTH * PackedPiece::BOARD_LENGTH];
+
+    constexpr SquareScores() : values() {
+        // Bonus by row counted from the piece's own side, and by column
+        const std::int32_t pawn_rows[8] = {0, 0, 5, 10, 20, 35, 60, 80};
+        const std::int32_t pawn_columns[8] = {0, 2, 5, 10, 10, 5, 2, 0};
+        const std::int32_t rook_rows[8] = {0, 5, 5, 5, 5, 5, 20, 10};
+        const std::int32_t rook_columns[8] = {0, 0, 5, 10, 10, 5, 0, 0};
+
+        const int length = PackedPiece::BOARD_LENGTH;
+        for (int key = 0; key < KEYS; key++) {
+            int type = key / 4;
+            bool moving_up = (key & 2) != 0;
+            int sign = (key & 1) ? 1 : -1;
+            for (int square = 0; square < length * length; square++) {
+                int row = moving_up ? square / length : length - 1 - square / length;
+                int col = square % length;
+                std::int32_t value = 0;
+                if (type == static_cast<int>(PieceType::Pawn)) {
+                    value = MATERIAL_PER_SIZE * 1 + pawn_rows[row] + pawn_columns[col];
+                } else if (type == static_cast<int>(PieceType::Rook)) {
+                    value = MATERIAL_PER_SIZE * 2 + rook_rows[row] + rook_columns[col];
+                }
+                values[key * length * length + square] = sign * value;
+            }
+        }
+    }
+};
+
+inline constexpr SquareScores SQUARE_SCORES{};
+
+/**
+ * @return The SQUARE_SCORES row for a piece: type * 4 + moving up * 2 + belongs to SCORED_PLAYER
+ */
+inline int scoreKey(const PackedPiece& piece) {
+    return static_cast<int>(piece.type()) * 4 + (piece.isMovingUp() ? 2 : 0) +
+           (piece.getColor() == SCORED_PLAYER ? 1 : 0);
+}
+
+/**
+ * @return What a piece standing on a square adds to the evaluation (0 for type NONE)
+ * @pre 0 <= square < BOARD_LENGTH * BOARD_LENGTH
+ */
+inline std::int32_t squareScore(const PackedPiece& piece, int square) {
+    return SQUARE_SCORES.values[scoreKey(piece) * PackedPiece::BOARD_LENGTH * PackedPiece::BOARD_LENGTH + square];
+}
+
+/**
+ * @brief Zobrist keys for pawns: one random 64-bit key per (owner, direction, square), where the
+ *      owner is SCORED_PLAYER or not. A board's pawn key is the XOR of the keys of its pawns, so
+ *      it changes only when a pawn appears, disappears or moves. Generated at compile time with
+ *      splitmix64 from a fixed seed, so keys are the same in every build and run.
+ */
+struct PawnKeys {
+    static const int KINDS = 4;     // scored player or not x moving up or down
+
+    std::uint64_t values[KINDS * PackedPiece::BOARD_LENGTH * PackedPiece::BOARD_LENGTH];
+
+    constexpr PawnKeys() : values() {
+        std::uint64_t state = 0x5041574E4B455953;
+        for (std::uint64_t& value : values) {
+            state += 0x9E3779B97F4A7C15;
+            std::uint64_t z = state;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+            value = z ^ (z >> 31);
+        }
+    }
+};
+
+inline constexpr PawnKeys PAWN_KEYS{};
+
+/**
+ * @return The Zobrist key of a piece standing on a square: a PAWN_KEYS entry for pawns, 0 otherwise
+ * @pre 0 <= square < BOARD_LENGTH * BOARD_LENGTH
+ */
+inline std::uint64_t pawnSquareKey(const PackedPiece& piece, int square) {
+    if (piece.type() != PieceType::Pawn) {
+        return 0;
+    }
+    int kind = (piece.getColor() == SCORED_PLAYER ? 2 : 0) + (piece.isMovingUp() ? 1 : 0);
+    return PAWN_KEYS.values[kind * PackedPiece::BOARD_LENGTH * PackedPiece::BOARD_LENGTH + square];
+}
+
+/**
+ * @brief Scores a board from scratch by summing squareScore() over its squares.
+ *      Board::evaluation() keeps the same number up to date incrementally; this is the reference.
+ */
+std::int32_t evaluate(const Board& board);
+
+/**
+ * @brief Scores many boards from scratch, eg. every position of a replayed game or an index.
+ *      With AVX2 each board is decoded 8 squares at a time and their SQUARE_SCORES entries are
+ *      fetched with one gather; otherwise it falls back to evaluate() per board.
+ * @param scores Receives count scores, scores[i] == evaluate(boards[i])
+ */
+void evaluateBatch(const Board* boards, std::size_t count, std::int32_t* scores);
+
+#endif
@@ -0,0 +1,217 @@
+// File: Fen.cpp
+// Date: 10/18/26
+// Implementation of the FEN-style parser and writer
+
+#include "Fen.hpp"
+#include <charconv>
+
+// Piece templates for the placement letters; the parser only fills in the square.
+// White pieces move up, and rooks start with the Rook default of 3 castle moves.
+static const PackedPiece WHITE_PAWN(PieceType::Pawn, Board::WHITE_PLAYER, -1, -1, true);
+static const PackedPiece BLACK_PAWN(PieceType::Pawn, Board::BLACK_PLAYER, -1, -1, false);
+static const PackedPiece WHITE_ROOK(PieceType::Rook, Board::WHITE_PLAYER, -1, -1, true, false, 3);
+static const PackedPiece BLACK_ROOK(PieceType::Rook, Board::BLACK_PLAYER, -1, -1, false, false, 3);
+
+// Splits off the next space-separated field of `text`, advancing `text` past it
+static std::string_view nextField(std::string_view& text) {
+    std::size_t space = text.find(' ');
+    std::string_view field = text.substr(0, space);
+    text = (space == std::string_view::npos) ? std::string_view() : text.substr(space + 1);
+    return field;
+}
+
+// Parses a square name such as "e2" into a square index, or -1
+static int parseSquare(char file, char rank) {
+    if (file < 'a' || file >= 'a' + Board::BOARD_LENGTH || rank < '1' || rank >= '1' + Board::BOARD_LENGTH) {
+        return -1;
+    }
+    return (rank - '1') * Board::BOARD_LENGTH + (file - 'a');
+}
+
+bool parseFen(std::string_view text, Board& board) {
+    // Squares are written raw and scored once, by rescore(), when the position is complete
+    board.clear();
+
+    // Rook squares in placement order, for the castle moves field
+    int rooks[Board::SQUARES];
+    int rook_count = 0;
+
+    // Placement: rows from the top (7) down to 0
+    std::string_view placement = nextField(text);
+    int row = Board::BOARD_LENGTH - 1;
+    int col = 0;
+    for (char c : placement) {
+        if (c == '/') {
+            if (col != Board::BOARD_LENGTH || row == 0) {
+                return false;
+            }
+            row--;
+            col = 0;
+        } else if (c >= '1' && c <= '8') {
+            col += c - '0';
+            if (col > Board::BOARD_LENGTH) {
+                return false;
+            }
+        } else {
+            if (col >= Board::BOARD_LENGTH) {
+                return false;
+            }
+            PackedPiece piece;
+            switch (c) {
+                case 'P': piece = WHITE_PAWN; break;
+                case 'p': piece = BLACK_PAWN; break;
+                case 'R': piece = WHITE_ROOK; rooks[rook_count++] = row * Board::BOARD_LENGTH + col; break;
+                case 'r': piece = BLACK_ROOK; rooks[rook_count++] = row * Board::BOARD_LENGTH + col; break;
+                default: return false;
+            }
+            piece.setPosition(row, col);
+            board.setSquare(row * Board::BOARD_LENGTH + col, piece);
+            col++;
+        }
+    }
+    if (row != 0 || col != Board::BOARD_LENGTH) {
+        return false;
+    }
+
+    // Side to move
+    std::string_view side = nextField(text);
+    if (side == "w") {
+        board.setSideToMove(Board::WHITE_PLAYER);
+    } else if (side == "b") {
+        board.setSideToMove(Board::BLACK_PLAYER);
+    } else {
+        return false;
+    }
+    if (text.empty()) {
+        board.rescore();
+        return true;
+    }
+
+    // Double jumps: a list of pawn squares
+    std::string_view jumps = nextField(text);
+    if (jumps != "-") {
+        if (jumps.size() % 2 != 0) {
+            return false;
+        }
+        for (std::size_t i = 0; i < jumps.size(); i += 2) {
+            int square = parseSquare(jumps[i], jumps[i + 1]);
+            if (square == -1 || board.at(square).type() != PieceType::Pawn) {
+                return false;
+            }
+            PackedPiece pawn = board.at(square);
+            pawn.setDoubleJump(true);
+            board.setSquare(square, pawn);
+        }
+    }
+    board.rescore();
+    if (text.empty()) {
+        return true;
+    }
+
+    // Castle moves: one count per rook, in placement order
+    std::string_view castles = nextField(text);
+    if (!text.empty()) {
+        return false;
+    }
+    if (castles == "-") {
+        return true;
+    }
+    if (castles.empty() || castles.back() == ',') {
+        return false;
+    }
+    const char* cursor = castles.data();
+    const char* end = castles.data() + castles.size();
+    for (int i = 0; i < rook_count; i++) {
+        int moves = 0;
+        std::from_chars_result result = std::from_chars(cursor, end, moves);
+        if (result.ec != std::errc() || moves < 0) {
+            return false;
+        }
+        cursor = result.ptr;
+        if (cursor != end && *cursor++ != ',') {
+            return false;
+        }
+        PackedPiece rook = board.at(rooks[i]);
+        rook.setCastleMovesLeft(moves);
+        board.setSquare(rooks[i], rook);
+    }
+    return cursor == end;
+}
+
+std::size_t writeFen(const Board& board, char* out, std::size_t capacity) {
+    // Every field is bounded, so write into a local buffer and copy once at the end
+    char buffer[FEN_MAX_LENGTH];
+    char* cursor = buffer;
+    char* end = buffer + FEN_MAX_LENGTH;
+
+    // Castle moves are written in placement order, so remember the rooks on the way
+    int rooks[Board::SQUARES];
+    int rook_count = 0;
+
+    // Placement
+    for (int row = Board::BOARD_LENGTH - 1; row >= 0; row--) {
+        int empty = 0;
+        for (int col = 0; col < Board::BOARD_LENGTH; col++) {
+            const PackedPiece& piece = board.at(row * Board::BOARD_LENGTH + col);
+            if (piece.type() == PieceType::None) {
+                empty++;
+                continue;
+            }
+            if (empty > 0) {
+                *cursor++ = static_cast<char>('0' + empty);
+                empty = 0;
+            }
+            char letter = 'p';
+            if (piece.type() == PieceType::Rook) {
+                letter = 'r';
+                rooks[rook_count++] = row * Board::BOARD_LENGTH + col;
+            }
+            *cursor++ = (piece.getColor() == Board::WHITE_PLAYER) ? static_cast<char>(letter - 0x20) : letter;
+        }
+        if (empty > 0) {
+            *cursor++ = static_cast<char>('0' + empty);
+        }
+        *cursor++ = (row > 0) ? '/' : ' ';
+    }
+
+    // Side to move
+    *cursor++ = (board.sideToMove() == Board::WHITE_PLAYER) ? 'w' : 'b';
+    *cursor++ = ' ';
+
+    // Double jumps
+    char* jumps = cursor;
+    for (int square = 0; square < Board::SQUARES; square++) {
+        const PackedPiece& piece = board.at(square);
+        if (piece.type() == PieceType::Pawn && piece.canDoubleJump()) {
+            *cursor++ = static_cast<char>('a' + piece.getColumn());
+            *cursor++ = static_cast<char>('1' + piece.getRow());
+        }
+    }
+    if (cursor == jumps) {
+        *cursor++ = '-';
+    }
+    *cursor++ = ' ';
+
+    // Castle moves
+    if (rook_count == 0) {
+        *cursor++ = '-';
+    }
+    for (int i = 0; i < rook_count; i++) {
+        if (i > 0) {
+            *cursor++ = ',';
+        }
+        cursor = std::to_chars(cursor, end, board.at(rooks[i]).getCastleMovesLeft()).ptr;
+    }
+
+    std::size_t length = static_cast<std::size_t>(cursor - buffer);
+    if (length > capacity) {
+        return 0;
+    }
+    std::char_traits<char>::copy(out, buffer, length);
+    return length;
+}
+
+std::string toFen(const Board& board) {
+    char buffer[FEN_MAX_LENGTH];
+    return std::string(buffer, writeFen(board, buffer, sizeof(buffer)));
+}
@@ -0,0 +1,53 @@
+// File: Fen.hpp
+// Date: 10/18/26
+// An allocation-free FEN-style parser and writer for Board positions
+
+#ifndef FEN_HPP
+#define FEN_HPP
+
+#include "Board.hpp"
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * Format: "<placement> <side> <double-jumps> <castle-moves>"
+ *      placement    Ranks from row 7 down to row 0 separated by '/'. 'P'/'R' are WHITE pawns/rooks,
+ *                   'p'/'r' BLACK ones, and a digit 1-8 skips that many empty squares.
+ *                   White pieces move up, black pieces move down.
+ *      side         'w' or 'b'
+ *      double-jumps Squares of pawns that can double jump, eg. "a2c2h7", or '-'
+ *      castle-moves Castle moves left for each rook in placement order, comma separated, eg. "3,3,0", or '-'
+ * The last two fields are optional. Without them pawns cannot double jump and rooks have 3 castle moves,
+ * the Pawn and Rook constructor defaults.
+ *
+ * Example: the starting rows of a pawn-and-rook game
+ *      "r6r/pppppppp/8/8/8/8/PPPPPPPP/R6R w a2b2c2d2e2f2g2h2a7b7c7d7e7f7g7h7 3,3,3,3"
+ */
+
+// Longest text writeFen() can produce, including the double jump and castle fields
+const std::size_t FEN_MAX_LENGTH = 512;
+
+/**
+ * @brief Parses a FEN-style position straight into a Board. Does not allocate.
+ * @param text The position text. Leading/trailing spaces are not allowed.
+ * @param board Receives the position. On failure its contents are unspecified.
+ * @return True if the text was a valid position. False otherwise.
+ */
+bool parseFen(std::string_view text, Board& board);
+
+/**
+ * @brief Writes a Board as FEN-style text into a caller-provided buffer. Does not allocate.
+ * @param board The position to write
+ * @param out The buffer to write into (not NUL terminated)
+ * @param capacity The length of out. FEN_MAX_LENGTH is always enough.
+ * @return The number of characters written, or 0 if they did not fit
+ */
+std::size_t writeFen(const Board& board, char* out, std::size_t capacity);
+
+/**
+ * @brief Convenience wrapper around writeFen() returning a string
+ */
+std::string toFen(const Board& board);
+
+#endif
@@ -0,0 +1,156 @@
+// File: GameCodec.cpp
+// Date: 10/18/26
+// Implementation of the binary game encoder and decoder
+
+#include "GameCodec.hpp"
+#include <cstring>
+
+static const char GAME_CODEC_MAGIC[4] = { 'C', 'B', 'G', 'R' };
+
+GameResult gameResultFromString(std::string_view result) {
+    if (result == "1-0") {
+        return GameResult::WhiteWins;
+    } else if (result == "0-1") {
+        return GameResult::BlackWins;
+    } else if (result == "1/2-1/2") {
+        return GameResult::Draw;
+    }
+    return GameResult::Unknown;
+}
+
+// Zigzag coding folds signed deltas into small unsigned numbers: 0, -1, 1, -2, ... -> 0, 1, 2, 3, ...
+static std::uint64_t zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+static std::int64_t unzigzag(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+GameEncoder::GameEncoder() : previous_moves_(0) {
+    buffer_.insert(buffer_.end(), GAME_CODEC_MAGIC, GAME_CODEC_MAGIC + sizeof(GAME_CODEC_MAGIC));
+    buffer_.push_back(static_cast<char>(GAME_CODEC_VERSION));
+}
+
+void GameEncoder::appendVarint(std::uint64_t value) {
+    while (value >= 0x80) {
+        buffer_.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    buffer_.push_back(static_cast<char>(value));
+}
+
+void GameEncoder::addGame(std::string_view fen, GameResult result, const Move* moves, std::size_t count) {
+    // Archives tend to repeat one start position, so a repeat costs a bit instead of the text
+    bool repeat = !fen.empty() && fen == previous_fen_;
+    bool write_fen = !fen.empty() && !repeat;
+    std::uint32_t move_count = static_cast<std::uint32_t>(count);
+    appendVarint((write_fen ? 1u : 0u) | static_cast<unsigned>(result) << 1 | (repeat ? 8u : 0u));
+    appendVarint(zigzag(static_cast<std::int64_t>(move_count) - previous_moves_));
+    previous_moves_ = move_count;
+    if (write_fen) {
+        appendVarint(fen.size());
+        buffer_.insert(buffer_.end(), fen.begin(), fen.end());
+    }
+    previous_fen_.assign(fen.data(), fen.size());
+
+    std::size_t start = buffer_.size();
+    buffer_.resize(start + 2 * count);
+    char* out = buffer_.data() + start;
+    for (std::size_t i = 0; i < count; i++) {
+        std::uint16_t bits = moves[i].encode();
+        out[2 * i] = static_cast<char>(bits & 0xFF);
+        out[2 * i + 1] = static_cast<char>(bits >> 8);
+    }
+}
+
+bool GameEncoder::addGame(const GameRecord& game) {
+    moves_.clear();
+    std::vector<Move>& moves = moves_;
+    if (replayGame(game, board_, [&moves](const Board&, const Move& move, const Undo&) { moves.push_back(move); }) < 0) {
+        return false;
+    }
+    addGame(game.fen, gameResultFromString(game.result), moves_.data(), moves_.size());
+    return true;
+}
+
+GameDecoder::GameDecoder() :
+    cursor_(nullptr),
+    end_(nullptr),
+    previous_moves_(0),
+    corrupt_(false) {
+}
+
+bool GameDecoder::open(std::string_view data) {
+    cursor_ = nullptr;
+    end_ = nullptr;
+    previous_moves_ = 0;
+    previous_fen_ = std::string_view();
+    corrupt_ = false;
+    if (data.size() < GAME_CODEC_HEADER || std::memcmp(data.data(), GAME_CODEC_MAGIC, sizeof(GAME_CODEC_MAGIC)) != 0 ||
+        static_cast<std::uint8_t>(data[4]) != GAME_CODEC_VERSION) {
+        return false;
+    }
+    cursor_ = reinterpret_cast<const unsigned char*>(data.data()) + GAME_CODEC_HEADER;
+    end_ = reinterpret_cast<const unsigned char*>(data.data()) + data.size();
+    return true;
+}
+
+bool GameDecoder::readVarint(std::uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (cursor_ == end_) {
+            return false;
+        }
+        unsigned char byte = *cursor_++;
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool GameDecoder::next(EncodedGame& game) {
+    if (cursor_ == end_) {
+        return false;
+    }
+
+    std::uint64_t info;
+    std::uint64_t delta;
+    if (!readVarint(info) || info > 15 || (info & 9) == 9 || !readVarint(delta)) {
+        corrupt_ = true;
+        cursor_ = end_;
+        return false;
+    }
+    std::int64_t move_count = static_cast<std::int64_t>(previous_moves_) + unzigzag(delta);
+
+    game.result = static_cast<GameResult>((info >> 1) & 3);
+    game.fen = (info & 8) ? previous_fen_ : std::string_view();
+    if (info & 1) {
+        std::uint64_t length;
+        if (!readVarint(length) || length > FEN_MAX_LENGTH || length > static_cast<std::uint64_t>(end_ - cursor_)) {
+            corrupt_ = true;
+            cursor_ = end_;
+            return false;
+        }
+        game.fen = std::string_view(reinterpret_cast<const char*>(cursor_), static_cast<std::size_t>(length));
+        cursor_ += length;
+    }
+
+    if (move_count < 0 || static_cast<std::uint64_t>(move_count) > static_cast<std::uint64_t>(end_ - cursor_) / 2) {
+        corrupt_ = true;
+        cursor_ = end_;
+        return false;
+    }
+    game.move_count = static_cast<std::uint32_t>(move_count);
+    game.moves = cursor_;
+    cursor_ += 2 * game.move_count;
+    previous_moves_ = game.move_count;
+    previous_fen_ = game.fen;
+    return true;
+}
+
+int replayEncoded(const EncodedGame& game, Board& board) {
+    return replayEncoded(game, board, [](const Board&, const Move&, const Undo&) {});
+}
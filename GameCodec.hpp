@@ -0,0 +1,169 @@
+// File: GameCodec.hpp
+// Date: 10/18/26
+// A compact binary game format: 16-bit moves behind a small varint-coded header,
+// with a streaming encoder and a zero-copy decoder that feeds Board::makeMove()
+
+#ifndef GAME_CODEC_HPP
+#define GAME_CODEC_HPP
+
+#include "Board.hpp"
+#include "Fen.hpp"
+#include "GameReader.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Stream layout:
+ *      "CBGR" <version byte> then one record per game:
+ *      varint   info         bit 0: a start position follows, bits 1-2: GameResult,
+ *                            bit 3: same start position as the previous game
+ *      varint   move delta   Move count minus the previous game's move count, zigzag coded
+ *      [varint  fen length, fen bytes]   Only with info bit 0
+ *      With neither bit 0 nor bit 3 the game starts from START_FEN.
+ *      uint16   moves[]      Move::encode(), little-endian
+ * Varints are LEB128: 7 bits per byte, low bits first, high bit set on all but the last byte.
+ */
+const std::uint8_t GAME_CODEC_VERSION = 1;
+const std::size_t GAME_CODEC_HEADER = 5;
+
+// Game outcomes, as stored in the info field
+enum class GameResult : std::uint8_t {
+    Unknown = 0,    // "*" or no Result tag
+    WhiteWins = 1,  // "1-0"
+    BlackWins = 2,  // "0-1"
+    Draw = 3        // "1/2-1/2"
+};
+
+/**
+ * @brief Maps a Result tag value to a GameResult
+ */
+GameResult gameResultFromString(std::string_view result);
+
+/**
+ * @brief Appends encoded games to a buffer. The buffer can be written out and cleared between
+ *      games (eg. whenever it passes a few MB), so an archive of any size streams through a
+ *      bounded buffer. The move count delta carries over.
+ */
+class GameEncoder {
+    private:
+        std::vector<char> buffer_;          // Encoded bytes not yet taken by the caller
+        std::uint32_t previous_moves_;      // Move count of the last game, for the delta
+        std::string previous_fen_;          // Start position of the last game, empty for START_FEN
+        Board board_;                       // Scratch board for resolving text moves
+        std::vector<Move> moves_;           // Scratch move list, reused between games
+
+        void appendVarint(std::uint64_t value);
+
+    public:
+        /**
+         * @brief Default constructor: the buffer starts with the stream header
+         */
+        GameEncoder();
+
+        /**
+         * @brief Appends a game given as its start position and moves
+         * @param fen The start position, or empty for START_FEN
+         * @param result The outcome
+         * @param moves The moves, in order
+         * @param count The number of moves
+         */
+        void addGame(std::string_view fen, GameResult result, const Move* moves, std::size_t count);
+
+        /**
+         * @brief Resolves a text game's moves (see replayGame()) and appends it
+         * @return False (and nothing is appended) if the game cannot be replayed
+         */
+        bool addGame(const GameRecord& game);
+
+        /**
+         * @return The bytes encoded since the last clear()
+         */
+        const std::vector<char>& data() const { return buffer_; }
+
+        /**
+         * @brief Drops the encoded bytes, eg. after writing them out. Later games continue the same stream.
+         */
+        void clear() { buffer_.clear(); }
+};
+
+/**
+ * @brief One game as decoded from a stream. The moves are read in place from the stream bytes.
+ */
+struct EncodedGame {
+    GameResult result = GameResult::Unknown;
+    std::string_view fen;                   // Start position, empty for START_FEN
+    std::uint32_t move_count = 0;           // Number of moves
+    const unsigned char* moves = nullptr;   // move_count little-endian 16-bit moves
+
+    /**
+     * @return Move i, decoded
+     * @pre i < move_count
+     */
+    Move move(std::uint32_t i) const {
+        return Move::decode(static_cast<std::uint16_t>(moves[2 * i] | moves[2 * i + 1] << 8));
+    }
+};
+
+/**
+ * @brief Walks the games of an encoded stream held in memory (a buffer or a mapped file).
+ *      The view does not own the bytes, which must outlive it.
+ */
+class GameDecoder {
+    private:
+        const unsigned char* cursor_;       // Next record
+        const unsigned char* end_;          // One past the last byte
+        std::uint32_t previous_moves_;      // Move count of the last game, for the delta
+        std::string_view previous_fen_;     // Start position of the last game, empty for START_FEN
+        bool corrupt_;                      // Set when a record runs past the end or is malformed
+
+        bool readVarint(std::uint64_t& value);
+
+    public:
+        GameDecoder();
+
+        /**
+         * @brief Starts decoding a stream
+         * @return False if the stream header is missing or has another version
+         */
+        bool open(std::string_view data);
+
+        /**
+         * @param game Receives the next game
+         * @return True if there was another game. False at the end, or if the stream is corrupt.
+         */
+        bool next(EncodedGame& game);
+
+        /**
+         * @return True if decoding stopped on a malformed record rather than at the end
+         */
+        bool isCorrupt() const { return corrupt_; }
+};
+
+/**
+ * @brief Sets up an encoded game and plays its moves straight into Board::makeMove().
+ *      The moves are trusted (the encoder resolved them), so they are not validated.
+ * @param onMove Called as onMove(board, move, undo) after each move is made
+ * @return The number of moves played, or -1 if the start position is invalid
+ */
+template <typename MoveVisitor>
+int replayEncoded(const EncodedGame& game, Board& board, MoveVisitor&& onMove) {
+    if (!parseFen(game.fen.empty() ? std::string_view(START_FEN) : game.fen, board)) {
+        return -1;
+    }
+    for (std::uint32_t i = 0; i < game.move_count; i++) {
+        Move move = game.move(i);
+        Undo undo = board.makeMove(move);
+        onMove(static_cast<const Board&>(board), move, undo);
+    }
+    return static_cast<int>(game.move_count);
+}
+
+/**
+ * @brief Replays an encoded game without visiting its moves
+ */
+int replayEncoded(const EncodedGame& game, Board& board);
+
+#endif
@@ -0,0 +1,319 @@
+// File: GameReader.cpp
+// Date: 10/18/26
+// Implementation of the game archive reader
+
+#include "GameReader.hpp"
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+const char* const START_FEN =
+    "r6r/pppppppp/8/8/8/8/PPPPPPPP/R6R w a2b2c2d2e2f2g2h2a7b7c7d7e7f7g7h7 3,3,3,3";
+
+// True for bytes that end a move token: whitespace/control characters and comment/variation openers
+static inline bool isDelimiter(char c) {
+    return static_cast<unsigned char>(c) <= ' ' || c == '{' || c == '(' || c == ')' || c == ';';
+}
+
+// Finds the first delimiter in [p, end), 16 bytes at a time where SSE2 is available
+static const char* findDelimiter(const char* p, const char* end) {
+#ifdef __SSE2__
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i brace = _mm_set1_epi8('{');
+    const __m128i open = _mm_set1_epi8('(');
+    const __m128i close = _mm_set1_epi8(')');
+    const __m128i semicolon = _mm_set1_epi8(';');
+    while (end - p >= 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        // Unsigned bytes <= ' ' are exactly those where min(byte, ' ') == byte
+        __m128i hits = _mm_cmpeq_epi8(_mm_min_epu8(bytes, space), bytes);
+        hits = _mm_or_si128(hits, _mm_cmpeq_epi8(bytes, brace));
+        hits = _mm_or_si128(hits, _mm_cmpeq_epi8(bytes, open));
+        hits = _mm_or_si128(hits, _mm_cmpeq_epi8(bytes, close));
+        hits = _mm_or_si128(hits, _mm_cmpeq_epi8(bytes, semicolon));
+        int mask = _mm_movemask_epi8(hits);
+        if (mask != 0) {
+            return p + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+        p += 16;
+    }
+#endif
+    while (p < end && !isDelimiter(*p)) {
+        p++;
+    }
+    return p;
+}
+
+static inline const char* skipSpaces(const char* p, const char* end) {
+    while (p < end && static_cast<unsigned char>(*p) <= ' ') {
+        p++;
+    }
+    return p;
+}
+
+// Finds `c` in [p, end), or returns end. memchr is already vectorized by the C library.
+static inline const char* findByte(const char* p, const char* end, char c) {
+    const void* found = std::memchr(p, c, static_cast<std::size_t>(end - p));
+    return found ? static_cast<const char*>(found) : end;
+}
+
+// Finds the next '[' that starts a line, ie. the next game's first tag pair, or returns end.
+// '[' is rare in movetext, so jumping between them skips whole games at a time.
+static const char* findTagLine(const char* p, const char* end) {
+    while ((p = findByte(p, end, '[')) != end) {
+        if (p[-1] == '\n') {
+            return p;
+        }
+        p++;
+    }
+    return end;
+}
+
+static bool isResult(std::string_view token) {
+    return token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*";
+}
+
+MoveTokenizer::MoveTokenizer(std::string_view movetext) :
+    cursor_(movetext.data()),
+    end_(movetext.data() + movetext.size()) {
+}
+
+bool MoveTokenizer::next(std::string_view& san) {
+    while (true) {
+        cursor_ = skipSpaces(cursor_, end_);
+        if (cursor_ == end_) {
+            return false;
+        }
+
+        char c = *cursor_;
+        if (c == '{') {
+            cursor_ = findByte(cursor_, end_, '}');
+            cursor_ += (cursor_ != end_);
+            continue;
+        }
+        if (c == ';') {
+            cursor_ = findByte(cursor_, end_, '\n');
+            continue;
+        }
+        if (c == '(') {
+            // Variations nest and may contain comments with parentheses in them
+            int depth = 0;
+            for (; cursor_ < end_; cursor_++) {
+                if (*cursor_ == '(') {
+                    depth++;
+                } else if (*cursor_ == ')' && --depth == 0) {
+                    cursor_++;
+                    break;
+                } else if (*cursor_ == '{') {
+                    cursor_ = findByte(cursor_, end_, '}');
+                    if (cursor_ == end_) {
+                        break;
+                    }
+                }
+            }
+            continue;
+        }
+        if (c == ')') {
+            cursor_++;
+            continue;
+        }
+
+        const char* token_end = findDelimiter(cursor_, end_);
+        std::string_view token(cursor_, static_cast<std::size_t>(token_end - cursor_));
+        cursor_ = token_end;
+        if (c == '$') {
+            continue;
+        }
+        if (isResult(token)) {
+            cursor_ = end_;
+            return false;
+        }
+
+        // Move numbers, possibly glued to the move ("12.e4", "12...Rxd1")
+        std::size_t i = 0;
+        while (i < token.size() && token[i] >= '0' && token[i] <= '9') {
+            i++;
+        }
+        if (i > 0) {
+            if (i == token.size() || token[i] != '.') {
+                continue;
+            }
+            while (i < token.size() && token[i] == '.') {
+                i++;
+            }
+            token.remove_prefix(i);
+            if (token.empty()) {
+                continue;
+            }
+        }
+        san = token;
+        return true;
+    }
+}
+
+GameParser::GameParser() : begin_(nullptr), cursor_(nullptr), end_(nullptr) {
+}
+
+GameParser::GameParser(std::string_view text) {
+    reset(text);
+}
+
+void GameParser::reset(std::string_view text) {
+    begin_ = text.data();
+    cursor_ = begin_;
+    end_ = begin_ + text.size();
+}
+
+// Reads a [Name "Value"] line into the game if it is one of the tags replaying needs
+static void parseTag(std::string_view line, GameRecord& game) {
+    std::size_t space = line.find(' ');
+    std::size_t first_quote = line.find('"');
+    std::size_t last_quote = line.rfind('"');
+    if (space == std::string_view::npos || first_quote == std::string_view::npos || last_quote <= first_quote) {
+        return;
+    }
+    std::string_view name = line.substr(1, space - 1);
+    std::string_view value = line.substr(first_quote + 1, last_quote - first_quote - 1);
+    if (name == "FEN") {
+        game.fen = value;
+    } else if (name == "Result") {
+        game.result = value;
+    }
+}
+
+bool GameParser::next(GameRecord& game) {
+    cursor_ = skipSpaces(cursor_, end_);
+    if (cursor_ == end_) {
+        return false;
+    }
+
+    game = GameRecord();
+    const char* start = cursor_;
+
+    // Tag pairs, one per line
+    while (cursor_ < end_ && *cursor_ == '[') {
+        const char* line_end = findByte(cursor_, end_, '\n');
+        parseTag(std::string_view(cursor_, static_cast<std::size_t>(line_end - cursor_)), game);
+        cursor_ = skipSpaces(line_end, end_);
+    }
+    game.tags = std::string_view(start, static_cast<std::size_t>(cursor_ - start));
+
+    // Movetext, up to the next game's tags
+    const char* movetext = cursor_;
+    cursor_ = findTagLine(cursor_, end_);
+    game.movetext = std::string_view(movetext, static_cast<std::size_t>(cursor_ - movetext));
+    game.text = std::string_view(start, static_cast<std::size_t>(cursor_ - start));
+    return true;
+}
+
+bool setupGame(const GameRecord& game, Board& board) {
+    return parseFen(game.fen.empty() ? std::string_view(START_FEN) : game.fen, board);
+}
+
+int replayGame(const GameRecord& game, Board& board) {
+    return replayGame(game, board, [](const Board&, const Move&, const Undo&) {});
+}
+
+GameReader::GameReader() :
+    open_(false),
+    data_(nullptr),
+    bytes_(0),
+    released_(0) {
+}
+
+GameReader::~GameReader() {
+    close();
+}
+
+bool GameReader::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    bytes_ = static_cast<std::size_t>(info.st_size);
+    if (bytes_ > 0) {
+        void* mapping = mmap(nullptr, bytes_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            bytes_ = 0;
+            return false;
+        }
+        // Read front to back: ask for aggressive read-ahead
+        madvise(mapping, bytes_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(mapping);
+    }
+    // The mapping keeps the file alive
+    ::close(fd);
+
+    open_ = true;
+    released_ = 0;
+    stats_ = ReaderStats();
+    parser_.reset(text());
+    return true;
+}
+
+void GameReader::close() {
+    if (data_ != nullptr) {
+        munmap(const_cast<char*>(data_), bytes_);
+    }
+    open_ = false;
+    data_ = nullptr;
+    bytes_ = 0;
+    released_ = 0;
+    parser_.reset(std::string_view());
+}
+
+void GameReader::releaseConsumed() {
+    std::size_t consumed = parser_.offset();
+    if (consumed - released_ < RELEASE_WINDOW) {
+        return;
+    }
+    // Only whole pages can be released; the mapping itself is page aligned
+    std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    std::size_t release_end = consumed / page * page;
+    madvise(const_cast<char*>(data_) + released_, release_end - released_, MADV_DONTNEED);
+    released_ = release_end;
+}
+
+bool GameReader::next(GameRecord& game) {
+    if (!parser_.next(game)) {
+        stats_.bytes = parser_.offset();
+        return false;
+    }
+    stats_.games++;
+    stats_.bytes = parser_.offset();
+    releaseConsumed();
+    return true;
+}
+
+void GameReader::replayAll(Board& board) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    GameRecord game;
+    while (next(game)) {
+        int moves = replayGame(game, board);
+        if (moves < 0) {
+            stats_.games_skipped++;
+        } else {
+            stats_.games_replayed++;
+            stats_.moves += static_cast<std::uint64_t>(moves);
+        }
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    stats_.seconds += elapsed.count();
+}
@@ -0,0 +1,202 @@
+// File: GameReader.hpp
+// Date: 10/18/26
+// A zero-copy reader for PGN-style game archives. The archive is memory mapped and
+// games, tags and moves are handed out as string_views into the mapping.
+
+#ifndef GAME_READER_HPP
+#define GAME_READER_HPP
+
+#include "Board.hpp"
+#include "Fen.hpp"
+#include "San.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * Position used by games without a [FEN "..."] tag: a rook in each corner, a full row of
+ * pawns in front, every pawn able to double jump and every rook with 3 castle moves.
+ */
+extern const char* const START_FEN;
+
+/**
+ * @brief One game of an archive, as views into the archive text. Nothing is copied;
+ *      the views stay valid as long as the text does.
+ */
+struct GameRecord {
+    std::string_view text;      // The whole game: tag pairs and movetext
+    std::string_view tags;      // The tag pair lines
+    std::string_view movetext;  // Move numbers, moves, comments, variations and the result
+    std::string_view fen;       // Value of the FEN tag, empty if there is none
+    std::string_view result;    // Value of the Result tag, empty if there is none
+};
+
+/**
+ * @brief Hands out the moves of a game's movetext one at a time, skipping move numbers,
+ *      {comments}, ;comments, (variations) and $NAGs, and stopping at the result token.
+ */
+class MoveTokenizer {
+    private:
+        const char* cursor_;    // Next unread character
+        const char* end_;       // One past the last character
+
+    public:
+        explicit MoveTokenizer(std::string_view movetext);
+
+        /**
+         * @param san Receives the next move's text, eg. "exd5+" or "Rad1"
+         * @return True if there was another move. False at the end of the movetext.
+         */
+        bool next(std::string_view& san);
+};
+
+/**
+ * @brief Splits archive text into games. A game is its tag pair lines followed by its movetext,
+ *      and ends where a line starting with '[' begins the next one.
+ */
+class GameParser {
+    private:
+        const char* begin_;     // Start of the text
+        const char* cursor_;    // Start of the next game (or whitespace before it)
+        const char* end_;       // One past the last character
+
+    public:
+        GameParser();
+        explicit GameParser(std::string_view text);
+
+        /**
+         * @brief Starts over on new text
+         */
+        void reset(std::string_view text);
+
+        /**
+         * @param game Receives the next game
+         * @return True if there was another game. False at the end of the text.
+         */
+        bool next(GameRecord& game);
+
+        /**
+         * @return How many bytes of the text have been consumed
+         */
+        std::size_t offset() const { return static_cast<std::size_t>(cursor_ - begin_); }
+};
+
+/**
+ * @brief Sets the board up for a game: its FEN tag if it has one, START_FEN otherwise
+ * @return False if the FEN tag is not a valid position
+ */
+bool setupGame(const GameRecord& game, Board& board);
+
+/**
+ * @brief Sets up a game and plays its moves through Board::makeMove()
+ * @param game The game to replay
+ * @param board Receives the final position. If the game cannot be replayed it holds the
+ *      position before the first move that could not be resolved.
+ * @param onMove Called as onMove(board, move, undo) after each move is made
+ * @return The number of moves played, or -1 if the setup or a move could not be resolved
+ *      (eg. the game moves pieces other than pawns and rooks)
+ */
+template <typename MoveVisitor>
+int replayGame(const GameRecord& game, Board& board, MoveVisitor&& onMove) {
+    if (!setupGame(game, board)) {
+        return -1;
+    }
+
+    MoveTokenizer tokens(game.movetext);
+    std::string_view san;
+    Move move;
+    int played = 0;
+    while (tokens.next(san)) {
+        if (!parseSan(san, board, move)) {
+            return -1;
+        }
+        Undo undo = board.makeMove(move);
+        onMove(static_cast<const Board&>(board), move, undo);
+        played++;
+    }
+    return played;
+}
+
+/**
+ * @brief Replays a game without visiting its moves
+ */
+int replayGame(const GameRecord& game, Board& board);
+
+/**
+ * @brief Counters kept by a GameReader
+ */
+struct ReaderStats {
+    std::uint64_t bytes = 0;            // Archive bytes consumed
+    std::uint64_t games = 0;            // Games read
+    std::uint64_t games_replayed = 0;   // Games replayed to the end
+    std::uint64_t games_skipped = 0;    // Games that could not be replayed
+    std::uint64_t moves = 0;            // Moves made while replaying
+    double seconds = 0;                 // Time spent in replayAll()
+
+    double megabytesPerSecond() const { return seconds > 0 ? bytes / seconds / (1024.0 * 1024.0) : 0; }
+    double gamesPerSecond() const { return seconds > 0 ? games / seconds : 0; }
+};
+
+/**
+ * @brief Streams the games of an archive file. The file is mapped read-only and read front to back;
+ *      every RELEASE_WINDOW bytes the pages already consumed are handed back to the kernel, so
+ *      memory use stays bounded no matter how large the file is. (Views into released pages are
+ *      still valid; touching them just reads the file again.) Requires POSIX mmap.
+ */
+class GameReader {
+    public:
+        static const std::size_t RELEASE_WINDOW = std::size_t(64) << 20;
+
+    private:
+        bool open_;             // Whether a file is open
+        const char* data_;      // The mapping, or nullptr (also for an empty file)
+        std::size_t bytes_;     // File length
+        std::size_t released_;  // Bytes at the front already handed back to the kernel
+        GameParser parser_;     // Walks the mapping
+        ReaderStats stats_;     // Counters
+
+        // Hands back the pages before the parser's position once a window's worth has built up
+        void releaseConsumed();
+
+    public:
+        GameReader();
+        ~GameReader();
+
+        GameReader(const GameReader&) = delete;
+        GameReader& operator=(const GameReader&) = delete;
+
+        /**
+         * @brief Maps an archive file, closing any file that was open
+         * @return True if the file was mapped. An empty file opens with no games.
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief Unmaps the file. Views handed out are no longer valid.
+         */
+        void close();
+
+        bool isOpen() const { return open_; }
+
+        /**
+         * @return The whole mapped text, eg. to split it between threads
+         */
+        std::string_view text() const { return std::string_view(data_, bytes_); }
+
+        /**
+         * @param game Receives the next game, as views into the mapping
+         * @return True if there was another game. False at the end of the file.
+         */
+        bool next(GameRecord& game);
+
+        /**
+         * @brief Replays every remaining game onto the board, counting replayed and skipped games,
+         *      moves and elapsed time in stats()
+         */
+        void replayAll(Board& board);
+
+        const ReaderStats& stats() const { return stats_; }
+};
+
+#endif
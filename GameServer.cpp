@@ -0,0 +1,409 @@
+// File: GameServer.cpp
+// Date: 10/18/26
+// Implementation of the GameServer class and its test clients
+
+#include "GameServer.hpp"
+#include "Fen.hpp"
+#include "GameReader.hpp"
+#include "San.hpp"
+#include "Scheduler.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// Requests a game task handles before letting other games run
+static const int GAME_BATCH = 32;
+
+// Latency histogram: exact below 32 ns, then 16 buckets per power of two (about 6% wide)
+static int latencyBucket(std::uint64_t ns) {
+    if (ns < 32) {
+        return static_cast<int>(ns);
+    }
+    int msb = 63 - __builtin_clzll(ns);
+    int bucket = 32 + (msb - 5) * 16 + static_cast<int>((ns >> (msb - 4)) & 15);
+    return std::min(bucket, GameServer::LATENCY_BUCKETS - 1);
+}
+
+// Lower bound of a latency bucket, in ns
+static double latencyValue(int bucket) {
+    if (bucket < 32) {
+        return bucket;
+    }
+    int msb = 5 + (bucket - 32) / 16;
+    int sub = (bucket - 32) % 16;
+    return static_cast<double>(16 + sub) * static_cast<double>(std::uint64_t(1) << (msb - 4));
+}
+
+GameServer::WorkerStats::WorkerStats() {
+    for (std::atomic<std::uint64_t>& bucket : latency) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+GameServer::GameServer(int threads, std::size_t max_games, ResponseHandler handler) :
+    handler_(std::move(handler)),
+    stats_start_(std::chrono::steady_clock::now()) {
+    if (threads <= 0) {
+        threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    games_.reserve(max_games);
+    free_games_.reserve(max_games);
+    for (std::size_t i = 0; i < max_games; i++) {
+        games_.push_back(std::unique_ptr<Game>(new Game()));
+        // Hand out low ids first
+        free_games_.push_back(static_cast<std::uint32_t>(max_games - 1 - i));
+    }
+    for (int i = 0; i < threads; i++) {
+        stats_.push_back(std::unique_ptr<WorkerStats>(new WorkerStats()));
+    }
+    scheduler_.reset(new Scheduler(threads));
+}
+
+GameServer::~GameServer() {
+    // Drains the pool before the games go away
+    scheduler_.reset();
+}
+
+void GameServer::submit(std::uint32_t id, const GameRequest& request) {
+    Game& game = *games_[id];
+    game.inbox.push(request);
+    // Pairs with the fence in runGame(): either this sees the game unscheduled, or the task sees the request
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!game.scheduled.exchange(true)) {
+        scheduler_->spawn([this, id] { runGame(id); });
+    }
+}
+
+void GameServer::runGame(std::uint32_t id) {
+    Game& game = *games_[id];
+    WorkerStats& stats = *stats_[static_cast<std::size_t>(Scheduler::currentWorker())];
+
+    GameRequest request;
+    int handled = 0;
+    while (handled < GAME_BATCH) {
+        if (game.inbox.pop(request)) {
+            handle(id, game, request, stats);
+            handled++;
+            continue;
+        }
+        if (!game.inbox.empty()) {
+            // A push is halfway done; it will be linked in a moment
+            std::this_thread::yield();
+            continue;
+        }
+        // Out of requests: unschedule, then look once more for one that raced with us
+        game.scheduled.store(false);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (game.inbox.empty() || game.scheduled.exchange(true)) {
+            return;
+        }
+    }
+    // Let other games have the thread; this one goes to the back of the line
+    scheduler_->spawn([this, id] { runGame(id); });
+}
+
+void GameServer::handle(std::uint32_t id, Game& game, const GameRequest& request, WorkerStats& stats) {
+    GameResponse response;
+    response.game = id;
+
+    switch (request.type) {
+        case GameRequest::NEW:
+            game.arena.release();
+            game.history = nullptr;
+            game.ply = 0;
+            game.history_capacity = 0;
+            parseFen(START_FEN, game.board);
+            game.playing = true;
+            response.status = ResponseStatus::Started;
+            stats.started.fetch_add(1, std::memory_order_relaxed);
+            break;
+
+        case GameRequest::MOVE: {
+            Move move;
+            if (!game.playing) {
+                response.status = ResponseStatus::NotPlaying;
+            } else if (!parseSan(std::string_view(request.san, request.san_length), game.board, move)) {
+                response.status = ResponseStatus::Illegal;
+            } else {
+                game.board.makeMove(move);
+                if (game.ply == game.history_capacity) {
+                    // Grow geometrically; the old array stays in the arena until the game ends
+                    std::uint32_t capacity = std::max<std::uint32_t>(16, game.history_capacity * 2);
+                    Move* history = game.arena.allocateArray<Move>(capacity);
+                    std::copy(game.history, game.history + game.ply, history);
+                    game.history = history;
+                    game.history_capacity = capacity;
+                }
+                game.history[game.ply++] = move;
+                response.status = ResponseStatus::Moved;
+                response.move = move;
+                stats.moves.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (response.status != ResponseStatus::Moved) {
+                stats.rejected.fetch_add(1, std::memory_order_relaxed);
+            }
+            break;
+        }
+
+        case GameRequest::END:
+            if (!game.playing) {
+                response.status = ResponseStatus::NotPlaying;
+                stats.rejected.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+            game.playing = false;
+            response.ply = game.ply;
+            game.arena.release();
+            game.history = nullptr;
+            game.ply = 0;
+            game.history_capacity = 0;
+            response.status = ResponseStatus::Ended;
+            stats.ended.fetch_add(1, std::memory_order_relaxed);
+            break;
+    }
+
+    if (request.type != GameRequest::END) {
+        response.ply = game.ply;
+    }
+    std::chrono::nanoseconds latency = std::chrono::steady_clock::now() - request.submitted;
+    response.latency_ns = static_cast<std::uint64_t>(latency.count());
+    if (request.type == GameRequest::MOVE) {
+        stats.latency[latencyBucket(response.latency_ns)].fetch_add(1, std::memory_order_relaxed);
+    }
+    handler_(response);
+
+    // Only reuse the id once its END has been answered
+    if (response.status == ResponseStatus::Ended) {
+        std::lock_guard<std::mutex> lock(free_mutex_);
+        free_games_.push_back(id);
+    }
+}
+
+bool GameServer::openGame(std::uint32_t& game) {
+    {
+        std::lock_guard<std::mutex> lock(free_mutex_);
+        if (free_games_.empty()) {
+            return false;
+        }
+        game = free_games_.back();
+        free_games_.pop_back();
+    }
+    GameRequest request;
+    request.type = GameRequest::NEW;
+    request.submitted = std::chrono::steady_clock::now();
+    submit(game, request);
+    return true;
+}
+
+bool GameServer::submitMove(std::uint32_t game, std::string_view san) {
+    if (game >= games_.size() || san.empty() || san.size() > GameRequest::MAX_SAN) {
+        return false;
+    }
+    GameRequest request;
+    request.type = GameRequest::MOVE;
+    request.san_length = static_cast<std::uint8_t>(san.size());
+    std::copy(san.begin(), san.end(), request.san);
+    request.submitted = std::chrono::steady_clock::now();
+    submit(game, request);
+    return true;
+}
+
+bool GameServer::endGame(std::uint32_t game) {
+    if (game >= games_.size()) {
+        return false;
+    }
+    GameRequest request;
+    request.type = GameRequest::END;
+    request.submitted = std::chrono::steady_clock::now();
+    submit(game, request);
+    return true;
+}
+
+ServerStats GameServer::stats() const {
+    ServerStats total;
+    std::vector<std::uint64_t> latency(LATENCY_BUCKETS, 0);
+    for (const std::unique_ptr<WorkerStats>& worker : stats_) {
+        total.moves += worker->moves.load(std::memory_order_relaxed);
+        total.rejected += worker->rejected.load(std::memory_order_relaxed);
+        total.games_started += worker->started.load(std::memory_order_relaxed);
+        total.games_ended += worker->ended.load(std::memory_order_relaxed);
+        for (int bucket = 0; bucket < LATENCY_BUCKETS; bucket++) {
+            latency[static_cast<std::size_t>(bucket)] += worker->latency[bucket].load(std::memory_order_relaxed);
+        }
+    }
+
+    std::uint64_t samples = 0;
+    for (std::uint64_t count : latency) {
+        samples += count;
+    }
+    std::uint64_t p50 = (samples + 1) / 2;
+    std::uint64_t p99 = samples - samples / 100;
+    std::uint64_t seen = 0;
+    for (int bucket = 0; bucket < LATENCY_BUCKETS && samples > 0; bucket++) {
+        std::uint64_t before = seen;
+        seen += latency[static_cast<std::size_t>(bucket)];
+        if (before < p50 && seen >= p50) {
+            total.p50_us = latencyValue(bucket) / 1000.0;
+        }
+        if (before < p99 && seen >= p99) {
+            total.p99_us = latencyValue(bucket) / 1000.0;
+        }
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - stats_start_;
+    total.seconds = elapsed.count();
+    total.threads = threads();
+    return total;
+}
+
+void GameServer::resetStats() {
+    for (std::unique_ptr<WorkerStats>& worker : stats_) {
+        worker->moves.store(0, std::memory_order_relaxed);
+        worker->rejected.store(0, std::memory_order_relaxed);
+        worker->started.store(0, std::memory_order_relaxed);
+        worker->ended.store(0, std::memory_order_relaxed);
+        for (std::atomic<std::uint64_t>& bucket : worker->latency) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+    stats_start_ = std::chrono::steady_clock::now();
+}
+
+int GameServer::threads() const {
+    return static_cast<int>(stats_.size());
+}
+
+std::ostream& operator<<(std::ostream& out, const ServerStats& stats) {
+    out << "moves " << stats.moves << " rejected " << stats.rejected
+        << " games " << stats.games_started << "/" << stats.games_ended
+        << " p50 " << stats.p50_us << "us p99 " << stats.p99_us << "us"
+        << " moves/core/s " << stats.movesPerCoreSecond()
+        << " games/core/s " << stats.gamesPerCoreSecond()
+        << " threads " << stats.threads;
+    return out;
+}
+
+// Square name such as "e2"
+static std::string squareName(int square) {
+    std::string name;
+    name += static_cast<char>('a' + square % Board::BOARD_LENGTH);
+    name += static_cast<char>('1' + square / Board::BOARD_LENGTH);
+    return name;
+}
+
+void runLineClient(std::istream& in, std::ostream& out, int threads) {
+    std::mutex out_mutex;
+    GameServer server(threads, 4096, [&out, &out_mutex](const GameResponse& response) {
+        std::lock_guard<std::mutex> lock(out_mutex);
+        switch (response.status) {
+            case ResponseStatus::Started:
+                out << "STARTED " << response.game << std::endl;
+                break;
+            case ResponseStatus::Moved:
+                out << "MOVED " << response.game << " " << response.ply << " "
+                    << squareName(response.move.from) << "-" << squareName(response.move.to) << std::endl;
+                break;
+            case ResponseStatus::Illegal:
+                out << "ILLEGAL " << response.game << std::endl;
+                break;
+            case ResponseStatus::NotPlaying:
+                out << "NOT_PLAYING " << response.game << std::endl;
+                break;
+            case ResponseStatus::Ended:
+                out << "ENDED " << response.game << std::endl;
+                break;
+        }
+    });
+
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream words(line);
+        std::string command;
+        words >> command;
+
+        bool ok = true;
+        if (command == "NEW") {
+            std::uint32_t game;
+            ok = server.openGame(game);
+        } else if (command == "MOVE") {
+            std::uint32_t game;
+            std::string san;
+            ok = static_cast<bool>(words >> game >> san) && server.submitMove(game, san);
+        } else if (command == "END") {
+            std::uint32_t game;
+            ok = static_cast<bool>(words >> game) && server.endGame(game);
+        } else if (command == "LOAD") {
+            int games = 0;
+            int moves = 0;
+            ok = static_cast<bool>(words >> games >> moves) && games > 0 && moves >= 0;
+            if (ok) {
+                ServerStats stats = runLoadTest(server.threads(), games, moves);
+                std::lock_guard<std::mutex> lock(out_mutex);
+                out << "LOAD " << stats << std::endl;
+            }
+        } else if (command == "STATS") {
+            ServerStats stats = server.stats();
+            std::lock_guard<std::mutex> lock(out_mutex);
+            out << "STATS " << stats << std::endl;
+        } else if (command == "QUIT") {
+            break;
+        } else if (!command.empty()) {
+            ok = false;
+        }
+
+        if (!ok) {
+            std::lock_guard<std::mutex> lock(out_mutex);
+            out << "ERROR " << line << std::endl;
+        }
+    }
+}
+
+ServerStats runLoadTest(int threads, int games, int moves) {
+    // Both sides open a file, then shuffle their rooks back and forth
+    static const char* const OPENING[] = { "a4", "a5", "Ra3", "Ra6" };
+    static const char* const SHUFFLE[] = { "Rb3", "Rb6", "Ra3", "Ra6" };
+
+    std::atomic<int> finished(0);
+    std::mutex done_mutex;
+    std::condition_variable done;
+    GameServer* server = nullptr;
+
+    auto handler = [&](const GameResponse& response) {
+        switch (response.status) {
+            case ResponseStatus::Started:
+            case ResponseStatus::Moved:
+                if (response.ply < static_cast<std::uint32_t>(moves)) {
+                    server->submitMove(response.game, response.ply < 4 ? OPENING[response.ply] : SHUFFLE[(response.ply - 4) % 4]);
+                } else {
+                    server->endGame(response.game);
+                }
+                break;
+            case ResponseStatus::Illegal:
+                server->endGame(response.game);
+                break;
+            case ResponseStatus::NotPlaying:
+            case ResponseStatus::Ended:
+                if (finished.fetch_add(1) + 1 == games) {
+                    std::lock_guard<std::mutex> lock(done_mutex);
+                    done.notify_all();
+                }
+                break;
+        }
+    };
+
+    GameServer load_server(threads, static_cast<std::size_t>(games), handler);
+    server = &load_server;
+    load_server.resetStats();
+    for (int i = 0; i < games; i++) {
+        std::uint32_t game;
+        load_server.openGame(game);
+    }
+
+    std::unique_lock<std::mutex> lock(done_mutex);
+    done.wait(lock, [&] { return finished.load() == games; });
+    return load_server.stats();
+}
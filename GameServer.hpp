@@ -0,0 +1,198 @@
+// File: GameServer.hpp
+// Date: 10/18/26
+// An in-process server that runs move requests for thousands of concurrent games
+// on a work-stealing thread pool
+
+#ifndef GAME_SERVER_HPP
+#define GAME_SERVER_HPP
+
+#include "Arena.hpp"
+#include "Board.hpp"
+#include "MpscQueue.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+class Scheduler;
+
+/**
+ * @brief A request for one game, queued in the game's inbox
+ */
+struct GameRequest {
+    enum Type : std::uint8_t { NEW, MOVE, END };
+    static const std::size_t MAX_SAN = 11;
+
+    Type type = NEW;
+    std::uint8_t san_length = 0;
+    char san[MAX_SAN] = {};     // Algebraic move text for MOVE, eg. "Rxd5+"
+    std::chrono::steady_clock::time_point submitted;    // For the latency metrics
+};
+
+// What happened to a request
+enum class ResponseStatus : std::uint8_t {
+    Started,    // NEW: the game is set up at START_FEN
+    Moved,      // MOVE: the move was played
+    Illegal,    // MOVE: the text does not name a legal move for the side to move
+    NotPlaying, // MOVE or END for a game that is not running
+    Ended       // END: the game's memory has been released
+};
+
+/**
+ * @brief Sent to the server's response handler for every request, on a pool thread
+ */
+struct GameResponse {
+    std::uint32_t game = 0;             // Game id
+    ResponseStatus status = ResponseStatus::Started;
+    Move move;                          // The move played (Moved only)
+    std::uint32_t ply = 0;              // Moves played in the game so far
+    std::uint64_t latency_ns = 0;       // Time from submission to response
+};
+
+/**
+ * @brief Server counters and latency percentiles since the last resetStats()
+ */
+struct ServerStats {
+    std::uint64_t moves = 0;            // Moves played
+    std::uint64_t rejected = 0;         // Illegal or NotPlaying requests
+    std::uint64_t games_started = 0;
+    std::uint64_t games_ended = 0;
+    double p50_us = 0;                  // Median MOVE latency, microseconds
+    double p99_us = 0;                  // 99th percentile MOVE latency, microseconds
+    double seconds = 0;                 // Time covered by the counters
+    int threads = 0;                    // Pool threads
+
+    double movesPerCoreSecond() const { return seconds > 0 ? moves / seconds / threads : 0; }
+    double gamesPerCoreSecond() const { return seconds > 0 ? games_ended / seconds / threads : 0; }
+};
+
+/**
+ * @brief Runs games as independent actors: each game has a non-blocking inbox (MpscQueue) and
+ *      is scheduled onto the pool whenever requests arrive for it, so one game's requests are
+ *      handled in order by one thread at a time while different games run in parallel.
+ *      A game's move history lives in its own Arena, released in one shot when the game ends.
+ *      Submitting never blocks on other games or on the pool. The pool is a work-stealing Scheduler.
+ */
+class GameServer {
+    public:
+        typedef std::function<void(const GameResponse&)> ResponseHandler;
+
+        static const int LATENCY_BUCKETS = 1024;
+
+    private:
+        struct Game {
+            MpscQueue<GameRequest> inbox;       // Requests not yet handled
+            std::atomic<bool> scheduled{false}; // Whether a pool task is (or is about to be) draining the inbox
+            bool playing = false;               // Between NEW and END
+            Board board;                        // Current position
+            Arena arena;                        // Backs the move history
+            Move* history = nullptr;            // Moves played, in the arena
+            std::uint32_t ply = 0;              // Moves in history
+            std::uint32_t history_capacity = 0; // Room in history
+        };
+
+        // Per pool thread, so counting never contends
+        struct alignas(64) WorkerStats {
+            std::atomic<std::uint64_t> moves{0};
+            std::atomic<std::uint64_t> rejected{0};
+            std::atomic<std::uint64_t> started{0};
+            std::atomic<std::uint64_t> ended{0};
+            std::atomic<std::uint64_t> latency[LATENCY_BUCKETS];    // Log-linear histogram of MOVE latency
+
+            WorkerStats();
+        };
+
+        std::vector<std::unique_ptr<Game>> games_;          // Game slots, indexed by game id
+        std::mutex free_mutex_;                             // Guards free_games_
+        std::vector<std::uint32_t> free_games_;             // Slots not in use
+        ResponseHandler handler_;                           // Receives every response
+        std::vector<std::unique_ptr<WorkerStats>> stats_;   // One per pool thread
+        std::chrono::steady_clock::time_point stats_start_; // When the counters were last reset
+        std::unique_ptr<Scheduler> scheduler_;              // Runs the game tasks
+
+        // Queues a request and schedules the game if no task is draining it
+        void submit(std::uint32_t game, const GameRequest& request);
+
+        // Pool task: handles a batch of a game's requests
+        void runGame(std::uint32_t game);
+
+        // Handles one request and sends the response
+        void handle(std::uint32_t id, Game& game, const GameRequest& request, WorkerStats& stats);
+
+    public:
+        /**
+         * @brief Parameterized constructor
+         * @param threads Pool threads. 0 uses std::thread::hardware_concurrency().
+         * @param max_games Most games that can run at once
+         * @param handler Receives every response, on pool threads (it must be thread safe)
+         */
+        GameServer(int threads, std::size_t max_games, ResponseHandler handler);
+
+        /**
+         * @brief Destructor: finishes queued requests and stops the pool
+         */
+        ~GameServer();
+
+        GameServer(const GameServer&) = delete;
+        GameServer& operator=(const GameServer&) = delete;
+
+        /**
+         * @brief Reserves a game and queues its NEW request
+         * @param game Receives the game id
+         * @return False if max_games are already running
+         */
+        bool openGame(std::uint32_t& game);
+
+        /**
+         * @brief Queues a move for a game
+         * @return False if the id or move text is invalid (nothing is queued)
+         */
+        bool submitMove(std::uint32_t game, std::string_view san);
+
+        /**
+         * @brief Queues the end of a game. Its id is reused once the END has been handled.
+         * @return False if the id is invalid
+         */
+        bool endGame(std::uint32_t game);
+
+        /**
+         * @return The counters and latency percentiles since the last reset
+         */
+        ServerStats stats() const;
+
+        void resetStats();
+
+        int threads() const;
+};
+
+/**
+ * @brief A line-based stand-in client for manual testing, eg. on stdin/stdout. Commands:
+ *      NEW                    Start a game; prints "STARTED <id>"
+ *      MOVE <id> <san>        Play a move; prints "MOVED <id> <ply> <from>-<to>" or "ILLEGAL <id>"
+ *      END <id>               End a game; prints "ENDED <id>"
+ *      LOAD <games> <moves>   Run runLoadTest() on a separate server and print its stats
+ *      STATS                  Print the server's stats
+ *      QUIT                   Stop (as does the end of input)
+ * @param threads Pool threads for the server
+ */
+void runLineClient(std::istream& in, std::ostream& out, int threads = 0);
+
+/**
+ * @brief Load test: opens `games` games at once and plays `moves` scripted moves in each,
+ *      submitting every move as soon as the previous one's response arrives
+ * @return The server's stats at the end
+ */
+ServerStats runLoadTest(int threads, int games, int moves);
+
+/**
+ * @brief Writes stats as one line: counts, p50/p99 latency, moves and games per core-second
+ */
+std::ostream& operator<<(std::ostream& out, const ServerStats& stats);
+
+#endif
@@ -0,0 +1,356 @@
+// File: MappedArrayBox.cpp
+// Date: 10/18/26
+// Implementation of the MappedArrayBox template class
+
+#ifndef MAPPED_ARRAY_BOX_CPP_
+#define MAPPED_ARRAY_BOX_CPP_
+
+#include "MappedArrayBox.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+template <typename T>
+MappedArrayBox<T>::MappedArrayBox() :
+    fd_(-1),
+    writable_(false),
+    sync_on_write_(true),
+    mapping_(nullptr),
+    mapped_bytes_(0),
+    header_(nullptr),
+    items_(nullptr) {
+}
+
+template <typename T>
+bool MappedArrayBox<T>::mapFile(std::size_t bytes) {
+    if (bytes < sizeof(MappedBoxHeader)) {
+        return false;
+    }
+
+    int protection = writable_ ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    void* mapping = mmap(nullptr, bytes, protection, MAP_SHARED, fd_, 0);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    // Validate the header against T and the file length
+    MappedBoxHeader* header = static_cast<MappedBoxHeader*>(mapping);
+    std::size_t expected = sizeof(MappedBoxHeader) + sizeof(T) * static_cast<std::size_t>(header->capacity);
+    if (std::memcmp(header->magic, "ARRAYBOX", 8) != 0 || header->version != 1 ||
+        header->item_bytes != sizeof(T) || header->capacity <= 0 ||
+        header->size < 0 || header->size > header->capacity || expected > bytes) {
+        munmap(mapping, bytes);
+        return false;
+    }
+
+    // A writer that never reached close() may have left damaged items, eg. a space of size 0
+    // that would stall every walk over them, so check those files item by item
+    const T* items = reinterpret_cast<const T*>(static_cast<const char*>(mapping) + sizeof(MappedBoxHeader));
+    for (int pos = 0; header->dirty != 0 && pos < header->size; pos += items[pos].size()) {
+        if (items[pos].size() < 1 || items[pos].size() > header->size - pos) {
+            munmap(mapping, bytes);
+            return false;
+        }
+    }
+
+    // Lookups jump around, so don't let the kernel read ahead
+    madvise(mapping, bytes, MADV_RANDOM);
+
+    mapping_ = mapping;
+    mapped_bytes_ = bytes;
+    header_ = header;
+    items_ = reinterpret_cast<T*>(static_cast<char*>(mapping) + sizeof(MappedBoxHeader));
+    return true;
+}
+
+template <typename T>
+bool MappedArrayBox<T>::openReadOnly(const std::string& path) {
+    close();
+
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    if (fd_ == -1) {
+        return false;
+    }
+
+    struct stat info;
+    writable_ = false;
+    if (fstat(fd_, &info) != 0 || !mapFile(static_cast<std::size_t>(info.st_size))) {
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+    return true;
+}
+
+template <typename T>
+bool MappedArrayBox<T>::openReadWrite(const std::string& path, int capacity) {
+    close();
+
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd_ == -1) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd_, &info) != 0) {
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    std::size_t bytes = static_cast<std::size_t>(info.st_size);
+    if (bytes == 0) {
+        // New file: write a header and size the file for `capacity` items
+        MappedBoxHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, "ARRAYBOX", 8);
+        header.version = 1;
+        header.item_bytes = sizeof(T);
+        header.capacity = (capacity <= 0) ? 64 : capacity;
+        header.size = 0;
+
+        bytes = sizeof(MappedBoxHeader) + sizeof(T) * static_cast<std::size_t>(header.capacity);
+        if (pwrite(fd_, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+            ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+    }
+
+    writable_ = true;
+    if (!mapFile(bytes)) {
+        ::close(fd_);
+        fd_ = -1;
+        writable_ = false;
+        return false;
+    }
+
+    // Cleared again by close() once every write has been synced
+    header_->dirty = 1;
+    msync(mapping_, sizeof(MappedBoxHeader), MS_SYNC);
+    return true;
+}
+
+template <typename T>
+void MappedArrayBox<T>::close() {
+    if (mapping_) {
+        if (writable_ && msync(mapping_, mapped_bytes_, MS_SYNC) == 0) {
+            header_->dirty = 0;
+            msync(mapping_, sizeof(MappedBoxHeader), MS_SYNC);
+        }
+        munmap(mapping_, mapped_bytes_);
+    }
+    if (fd_ != -1) {
+        ::close(fd_);
+    }
+    fd_ = -1;
+    writable_ = false;
+    mapping_ = nullptr;
+    mapped_bytes_ = 0;
+    header_ = nullptr;
+    items_ = nullptr;
+}
+
+template <typename T>
+bool MappedArrayBox<T>::isOpen() const {
+    return mapping_ != nullptr;
+}
+
+template <typename T>
+void MappedArrayBox<T>::setSyncOnWrite(bool enabled) {
+    sync_on_write_ = enabled;
+}
+
+template <typename T>
+bool MappedArrayBox<T>::sync() {
+    if (!writable_ || !mapping_) {
+        return false;
+    }
+    return msync(mapping_, mapped_bytes_, MS_SYNC) == 0;
+}
+
+template <typename T>
+bool MappedArrayBox<T>::flushRange(int first, int last) {
+    if (!sync_on_write_) {
+        return true;
+    }
+
+    // msync needs a page-aligned start address
+    long page = sysconf(_SC_PAGESIZE);
+    char* base = static_cast<char*>(mapping_);
+    char* begin = reinterpret_cast<char*>(items_ + first);
+    char* end = reinterpret_cast<char*>(items_ + last);
+    char* aligned = base + ((begin - base) / page) * page;
+
+    if (end <= begin) {
+        return true;
+    }
+    return msync(aligned, static_cast<std::size_t>(end - aligned), MS_SYNC) == 0;
+}
+
+template <typename T>
+bool MappedArrayBox<T>::publishSize(int size) {
+    header_->size = size;
+    if (!sync_on_write_) {
+        return true;
+    }
+    return msync(mapping_, sizeof(MappedBoxHeader), MS_SYNC) == 0;
+}
+
+template <typename T>
+int MappedArrayBox<T>::size() const {
+    return header_ ? header_->size : 0;
+}
+
+template <typename T>
+int MappedArrayBox<T>::capacity() const {
+    return header_ ? header_->capacity : 0;
+}
+
+template <typename T>
+const T& MappedArrayBox<T>::at(int index) const {
+    return items_[index];
+}
+
+template <typename T>
+int MappedArrayBox<T>::getIndexOf(const std::string& type, int start, int end) const {
+    int size = this->size();
+
+    // Check if the parameters are valid
+    if (start < 0 || start >= size || end < 0 || end > size || start >= end) {
+        return -1;
+    }
+
+    return slotIndexOf(items_, type, start, end);
+}
+
+template <typename T>
+bool MappedArrayBox<T>::addItem(const T& item) {
+    if (!writable_ || !header_) {
+        return false;
+    }
+
+    int size = header_->size;
+    int item_size = item.size();
+
+    // Check if there's enough space
+    if (size + item_size > header_->capacity) {
+        return false;
+    }
+
+    // Write the item into the leftmost non-occupied spaces and flush it, then publish the new size
+    for (int i = 0; i < item_size; i++) {
+        std::memcpy(static_cast<void*>(items_ + size + i), &item, sizeof(T));
+    }
+    bool flushed = flushRange(size, size + item_size);
+    return publishSize(size + item_size) && flushed;
+}
+
+template <typename T>
+bool MappedArrayBox<T>::remove(const std::string& type) {
+    if (!writable_ || !header_) {
+        return false;
+    }
+
+    int size = header_->size;
+    int index = getIndexOf(type, 0, size);
+    if (index == -1) {
+        return false;
+    }
+
+    // Shift later items left and flush them, then publish the new size. The freed tail is zeroed
+    // last, so a crash never leaves spaces of size 0 inside the size on disk.
+    int item_size = items_[index].size();
+    std::memmove(static_cast<void*>(items_ + index), items_ + index + item_size,
+                 sizeof(T) * static_cast<std::size_t>(size - index - item_size));
+    bool flushed = flushRange(index, size - item_size);
+    flushed = publishSize(size - item_size) && flushed;
+    std::memset(static_cast<void*>(items_ + size - item_size), 0, sizeof(T) * item_size);
+    return flushRange(size - item_size, size) && flushed;
+}
+
+template <typename T>
+int MappedArrayBox<T>::count(const std::string& type) const {
+    return slotCount(items_, type, size());
+}
+
+template <typename T>
+bool MappedArrayBox<T>::contains(const std::string& type) const {
+    return getIndexOf(type, 0, size()) != -1;
+}
+
+template <typename T>
+MappedArrayBox<T>::~MappedArrayBox() {
+    close();
+}
+
+template <typename T>
+MappedBoxBenchmark benchmarkMappedBox(const std::string& path, const std::vector<T>& items, int reads) {
+    using Clock = std::chrono::steady_clock;
+    MappedBoxBenchmark result;
+    reads = reads < 1 ? 1 : reads;
+    int capacity = 0;
+    for (const T& item : items) {
+        capacity += item.size();
+    }
+    capacity = capacity < 1 ? 1 : capacity;
+
+    // Save the box once; openReadWrite() would keep the capacity of an old file
+    std::remove(path.c_str());
+    {
+        MappedArrayBox<T> saved;
+        if (!saved.openReadWrite(path, capacity)) {
+            return result;
+        }
+        saved.setSyncOnWrite(false);
+        for (const T& item : items) {
+            saved.addItem(item);
+        }
+    }
+
+    Clock::time_point start = Clock::now();
+    MappedArrayBox<T> mapped;
+    if (!mapped.openReadOnly(path)) {
+        return result;
+    }
+    result.open_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    start = Clock::now();
+    ArrayBox<T> rebuilt(capacity);
+    for (const T& item : items) {
+        rebuilt.addItem(item);
+    }
+    result.rebuild_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    result.items = static_cast<int>(items.size());
+    if (mapped.size() == 0) {
+        return result;
+    }
+
+    // The same random spaces on both; the size sum keeps the reads from being optimized out
+    long long sum = 0;
+    std::minstd_rand random(1);
+    start = Clock::now();
+    for (int i = 0; i < reads; i++) {
+        sum += mapped.at(static_cast<int>(random() % mapped.size())).size();
+    }
+    result.mapped_access_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / reads;
+
+    random.seed(1);
+    start = Clock::now();
+    for (int i = 0; i < reads; i++) {
+        sum -= rebuilt.at(static_cast<int>(random() % rebuilt.size())).size();
+    }
+    result.rebuilt_access_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / reads;
+    if (sum != 0) {
+        result.items = -1;   // The two boxes disagree
+    }
+    return result;
+}
+
+#endif // MAPPED_ARRAY_BOX_CPP_
@@ -0,0 +1,193 @@
+// File: MappedArrayBox.hpp
+// Date: 10/18/26
+// An ArrayBox whose items_ buffer is a memory-mapped file, so large boxes can be
+// reopened without being rebuilt. POSIX only (mmap/msync).
+
+#ifndef MAPPED_ARRAY_BOX_HPP_
+#define MAPPED_ARRAY_BOX_HPP_
+
+#include "ArrayBox.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief On-disk header of a MappedArrayBox file. The items follow it directly:
+ *      [MappedBoxHeader][T x capacity]
+ *      The layout is fixed; a file can only be opened for the same T (checked via item_bytes).
+ */
+struct MappedBoxHeader {
+    char magic[8];              // "ARRAYBOX"
+    std::uint32_t version;      // Format version, currently 1
+    std::uint32_t item_bytes;   // sizeof(T) of the stored items
+    std::int32_t capacity;      // Number of item spaces in the file
+    std::int32_t size;          // Occupied spaces, [0, size)
+    std::uint64_t dirty;        // 1 while a writer has the file open, 0 once close() has synced it
+};
+
+static_assert(sizeof(MappedBoxHeader) == 32, "MappedBoxHeader is an on-disk layout");
+
+/**
+ * @brief Same contract as ArrayBox (items take up size() spaces, remove shifts left), sharing
+ *      its space layout and searches (slotIndexOf, slotCount), but items_ points into a
+ *      MAP_SHARED file mapping instead of the heap.
+ *      Opening a file that was closed cleanly is O(1): only the header is read and pages are
+ *      faulted in on access. A file whose writer never reached close() (eg. after a crash) is
+ *      walked item by item first, and rejected if an item is damaged.
+ *      T must be trivially copyable (eg. PackedPiece), since its bytes are the file format.
+ */
+template <typename T>
+class MappedArrayBox {
+    static_assert(std::is_trivially_copyable<T>::value, "MappedArrayBox needs a trivially copyable item type");
+
+    private:
+        int fd_;                    // Open file descriptor, -1 when closed
+        bool writable_;             // True if opened with openReadWrite()
+        bool sync_on_write_;        // True to msync the touched pages after every mutation
+        void* mapping_;             // Start of the mapping (the header)
+        std::size_t mapped_bytes_;  // Length of the mapping
+        MappedBoxHeader* header_;   // Header inside the mapping
+
+        /**
+         * @brief Maps the open file and validates its header, and its items if the header is dirty
+         * @return True if the file is a valid box for T. In a dirty file every item in [0, size)
+         *      must also take up at least one space and end by size.
+         */
+        bool mapFile(std::size_t bytes);
+
+        /**
+         * @brief Flushes the pages covering items [first, last) when sync_on_write_ is set
+         * @return True if the flush succeeded (or was not needed)
+         */
+        bool flushRange(int first, int last);
+
+        /**
+         * @brief Stores a new size in the header and, when sync_on_write_ is set, flushes it.
+         *      Mutations call this only after flushRange() of their items, so the size on disk
+         *      never covers spaces whose items have not reached the file.
+         * @return True if the flush succeeded (or was not needed)
+         */
+        bool publishSize(int size);
+
+    protected:
+        T* items_;      // Item array inside the mapping
+
+        /**
+         *  @brief Same as ArrayBox::getIndexOf: the leftmost index in [start, end)
+         *      whose item has the given type, or -1.
+         */
+        int getIndexOf(const std::string& type, int start, int end) const;
+
+    public:
+        /**
+         * @brief Default constructor
+         * @post The box is closed: size() and capacity() are 0 and every add fails.
+         */
+        MappedArrayBox();
+
+        MappedArrayBox(const MappedArrayBox& other) = delete;
+        MappedArrayBox& operator=(const MappedArrayBox& other) = delete;
+
+        /**
+         * @brief Maps an existing box file read-only. Only the header is touched.
+         * @param path A const reference to the path of the file
+         * @return True if the file was opened. False if it is missing or not a valid box for T.
+         */
+        bool openReadOnly(const std::string& path);
+
+        /**
+         * @brief Maps a box file for reading and writing, creating it if needed.
+         *      The header is marked dirty until close().
+         * @param path A const reference to the path of the file
+         * @param capacity The capacity of a newly created file. If not positive, 64 is used.
+         *      An existing file keeps the capacity it was created with.
+         * @return True if the file was opened or created. False otherwise.
+         */
+        bool openReadWrite(const std::string& path, int capacity = 64);
+
+        /**
+         * @brief Unmaps and closes the file. Writable boxes are synced first.
+         */
+        void close();
+
+        /**
+         * @return True if a file is currently mapped
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Chooses whether each addItem/remove msyncs the pages it touched (the default)
+         *      or leaves flushing to sync()/close()
+         */
+        void setSyncOnWrite(bool enabled);
+
+        /**
+         * @brief Synchronously flushes the whole mapping to the file
+         * @return True on success. False if msync failed or the box is not writable.
+         */
+        bool sync();
+
+        /**
+         * @return The number of occupied spaces stored in the file header
+         */
+        int size() const;
+
+        /**
+         * @return The capacity stored in the file header
+         */
+        int capacity() const;
+
+        /**
+         * @brief Same as ArrayBox::addItem. Fails on a read-only or closed box.
+         */
+        bool addItem(const T& item);
+
+        /**
+         * @brief Same as ArrayBox::remove (shifts later items left). Fails on a read-only or closed box.
+         */
+        bool remove(const std::string& type);
+
+        /**
+         * @brief Same as ArrayBox::count
+         */
+        int count(const std::string& type) const;
+
+        /**
+         * @brief Same as ArrayBox::contains
+         */
+        bool contains(const std::string& type) const;
+
+        /**
+         * @return The item occupying space `index`, for random access
+         * @pre 0 <= index < size()
+         */
+        const T& at(int index) const;
+
+        // Destructor: closes the file
+        ~MappedArrayBox();
+};
+
+/**
+ * @brief Results of benchmarkMappedBox(), in nanoseconds
+ */
+struct MappedBoxBenchmark {
+    int items = 0;                  // Items saved, or -1 if the two boxes read back differently
+    double open_ns = 0;             // openReadOnly() of the saved box
+    double rebuild_ns = 0;          // Adding every item to a fresh ArrayBox instead
+    double mapped_access_ns = 0;    // Per random at() right after opening (pages fault in lazily)
+    double rebuilt_access_ns = 0;   // Per random at() on the rebuilt ArrayBox
+};
+
+/**
+ * @brief Reopening versus rebuilding: saves the items to a box file at `path` (replacing it),
+ *      then times opening it read-only against adding the items to an ArrayBox from scratch,
+ *      and `reads` random at() calls on each
+ * @return The timings; all zero if the file could not be written or opened
+ */
+template <typename T>
+MappedBoxBenchmark benchmarkMappedBox(const std::string& path, const std::vector<T>& items, int reads = 1 << 20);
+
+#include "MappedArrayBox.cpp"
+#endif // MAPPED_ARRAY_BOX_HPP_
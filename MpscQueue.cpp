@@ -0,0 +1,52 @@
+// File: MpscQueue.cpp
+// Date: 10/18/26
+// Implementation of the MpscQueue template class
+
+#ifndef MPSC_QUEUE_CPP_
+#define MPSC_QUEUE_CPP_
+
+#include "MpscQueue.hpp"
+
+template <typename T>
+MpscQueue<T>::MpscQueue() {
+    Node* stub = new Node();
+    stub->next.store(nullptr, std::memory_order_relaxed);
+    head_.store(stub, std::memory_order_relaxed);
+    tail_ = stub;
+}
+
+template <typename T>
+MpscQueue<T>::~MpscQueue() {
+    while (tail_ != nullptr) {
+        Node* next = tail_->next.load(std::memory_order_relaxed);
+        delete tail_;
+        tail_ = next;
+    }
+}
+
+template <typename T>
+void MpscQueue<T>::push(const T& value) {
+    Node* node = new Node();
+    node->next.store(nullptr, std::memory_order_relaxed);
+    node->value = value;
+
+    // Claim the head, then link the previous head to us. Until the link is stored the
+    // consumer cannot reach this node, which is the gap pop() may briefly miss.
+    Node* previous = head_.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node, std::memory_order_release);
+}
+
+template <typename T>
+bool MpscQueue<T>::pop(T& value) {
+    Node* next = tail_->next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+        return false;
+    }
+    // next becomes the new stub once its value is taken
+    value = next->value;
+    delete tail_;
+    tail_ = next;
+    return true;
+}
+
+#endif
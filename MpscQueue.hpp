@@ -0,0 +1,60 @@
+// File: MpscQueue.hpp
+// Date: 10/18/26
+// A non-blocking multi-producer, single-consumer queue
+
+#ifndef MPSC_QUEUE_HPP_
+#define MPSC_QUEUE_HPP_
+
+#include <atomic>
+
+/**
+ * @brief An unbounded linked queue any number of threads can push to without locks or
+ *      waiting (one atomic exchange per push). Only one thread at a time may pop.
+ *      A pop can briefly miss an item whose push is still in progress; empty() sees it,
+ *      so a consumer that stops on an empty pop should re-check empty().
+ */
+template <typename T>
+class MpscQueue {
+    private:
+        struct Node {
+            std::atomic<Node*> next;    // Next (newer) node, nullptr at the head
+            T value;                    // The item (unused in the stub)
+        };
+
+        alignas(64) std::atomic<Node*> head_;   // Newest node, where producers link in
+        alignas(64) Node* tail_;                // Stub before the oldest item, owned by the consumer
+
+    public:
+        /**
+         * @brief Default constructor: an empty queue. T must be default constructible.
+         */
+        MpscQueue();
+
+        /**
+         * @brief Destructor: frees every queued item. No thread may be using the queue.
+         */
+        ~MpscQueue();
+
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        /**
+         * @brief Adds an item. Safe from any thread.
+         */
+        void push(const T& value);
+
+        /**
+         * @brief Removes the oldest item. Consumer thread only.
+         * @return False if no completely pushed item was waiting
+         */
+        bool pop(T& value);
+
+        /**
+         * @return True if nothing has been pushed since the last pop, counting pushes still in progress.
+         *      Consumer thread only.
+         */
+        bool empty() const { return head_.load(std::memory_order_acquire) == tail_; }
+};
+
+#include "MpscQueue.cpp"
+#endif // MPSC_QUEUE_HPP_
@@ -0,0 +1,181 @@
+// File: NeuralEvaluation.cpp
+// Date: 10/18/26
+// Implementation of the NeuralNetwork class
+
+#include "NeuralEvaluation.hpp"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+static const char NEURAL_NETWORK_MAGIC[4] = { 'C', 'B', 'N', 'N' };
+
+// Stands in for the rows an update does not use, so every update has the same shape
+alignas(32) static const std::int16_t ZERO_ROW[NeuralNetwork::HIDDEN] = {};
+
+// out = in + add - sub - sub2, over HIDDEN int16 entries (out may be in)
+static void updateRows(const std::int16_t* in, std::int16_t* out, const std::int16_t* add,
+                       const std::int16_t* sub, const std::int16_t* sub2) {
+    int i = 0;
+#ifdef __AVX2__
+    for (; i < NeuralNetwork::HIDDEN; i += 16) {
+        __m256i sum = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        sum = _mm256_add_epi16(sum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(add + i)));
+        sum = _mm256_sub_epi16(sum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sub + i)));
+        sum = _mm256_sub_epi16(sum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sub2 + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), sum);
+    }
+#endif
+    for (; i < NeuralNetwork::HIDDEN; i++) {
+        out[i] = static_cast<std::int16_t>(in[i] + add[i] - sub[i] - sub2[i]);
+    }
+}
+
+NeuralNetwork::NeuralNetwork() :
+    feature_bias_(),
+    feature_weights_(FEATURES, Accumulator()),
+    output_weights_(),
+    output_bias_(0),
+    output_shift_(0) {
+}
+
+bool NeuralNetwork::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    std::uint32_t header[4];
+    std::size_t expected = sizeof(NEURAL_NETWORK_MAGIC) + sizeof(header) +
+                           sizeof(feature_bias_) + feature_weights_.size() * sizeof(Accumulator) +
+                           sizeof(output_weights_) + sizeof(std::int32_t);
+    if (data.size() != expected || std::memcmp(data.data(), NEURAL_NETWORK_MAGIC, sizeof(NEURAL_NETWORK_MAGIC)) != 0) {
+        return false;
+    }
+    const char* cursor = data.data() + sizeof(NEURAL_NETWORK_MAGIC);
+    std::memcpy(header, cursor, sizeof(header));
+    cursor += sizeof(header);
+    if (header[0] != NEURAL_NETWORK_VERSION || header[1] != FEATURES || header[2] != HIDDEN || header[3] > 31) {
+        return false;
+    }
+
+    // The size check above covers every copy below (Accumulator has no padding)
+    std::memcpy(feature_bias_.values, cursor, sizeof(feature_bias_));
+    cursor += sizeof(feature_bias_);
+    std::memcpy(feature_weights_.data(), cursor, feature_weights_.size() * sizeof(Accumulator));
+    cursor += feature_weights_.size() * sizeof(Accumulator);
+    std::memcpy(output_weights_, cursor, sizeof(output_weights_));
+    cursor += sizeof(output_weights_);
+    std::memcpy(&output_bias_, cursor, sizeof(output_bias_));
+    output_shift_ = static_cast<int>(header[3]);
+    return true;
+}
+
+bool NeuralNetwork::save(const std::string& path) const {
+    std::vector<char> out(NEURAL_NETWORK_MAGIC, NEURAL_NETWORK_MAGIC + sizeof(NEURAL_NETWORK_MAGIC));
+    std::uint32_t header[4] = { NEURAL_NETWORK_VERSION, FEATURES, HIDDEN, static_cast<std::uint32_t>(output_shift_) };
+    auto append = [&out](const void* bytes, std::size_t length) {
+        out.insert(out.end(), static_cast<const char*>(bytes), static_cast<const char*>(bytes) + length);
+    };
+    append(header, sizeof(header));
+    append(feature_bias_.values, sizeof(feature_bias_));
+    append(feature_weights_.data(), feature_weights_.size() * sizeof(Accumulator));
+    append(output_weights_, sizeof(output_weights_));
+    append(&output_bias_, sizeof(output_bias_));
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(file);
+}
+
+void NeuralNetwork::refresh(const Board& board, Accumulator& acc) const {
+    acc = feature_bias_;
+    for (int square = 0; square < Board::SQUARES; square++) {
+        addPiece(acc, board.at(square), square);
+    }
+}
+
+void NeuralNetwork::addPiece(Accumulator& acc, const PackedPiece& piece, int square) const {
+    int feature = featureIndex(piece, square);
+    if (feature >= 0) {
+        updateRows(acc.values, acc.values, row(feature), ZERO_ROW, ZERO_ROW);
+    }
+}
+
+void NeuralNetwork::removePiece(Accumulator& acc, const PackedPiece& piece, int square) const {
+    int feature = featureIndex(piece, square);
+    if (feature >= 0) {
+        updateRows(acc.values, acc.values, ZERO_ROW, row(feature), ZERO_ROW);
+    }
+}
+
+void NeuralNetwork::applyMove(const Accumulator& before_acc, const Move& move, const Undo& undo,
+                              const Board& board, Accumulator& after_acc) const {
+    // The moved piece leaves move.from, anything captured leaves move.to,
+    // and the piece as it now stands (maybe promoted) arrives on move.to
+    int captured = featureIndex(undo.captured, move.to);
+    updateRows(before_acc.values, after_acc.values, row(featureIndex(board.at(move.to), move.to)),
+               row(featureIndex(undo.moved, move.from)), captured >= 0 ? row(captured) : ZERO_ROW);
+}
+
+void NeuralNetwork::apply(const ChangeRecord& record, Accumulator& acc) const {
+    const PackedPiece& piece = record.piece;
+    switch (record.kind) {
+        case ChangeKind::Added:
+            if (piece.onBoard()) {
+                addPiece(acc, piece, piece.square());
+            }
+            break;
+        case ChangeKind::Removed:
+            if (piece.onBoard()) {
+                removePiece(acc, piece, piece.square());
+            }
+            break;
+        case ChangeKind::Moved:
+            if (record.from_row >= 0 && record.from_column >= 0) {
+                removePiece(acc, piece, record.from_row * Board::BOARD_LENGTH + record.from_column);
+            }
+            if (piece.onBoard()) {
+                addPiece(acc, piece, piece.square());
+            }
+            break;
+        case ChangeKind::Reset:
+            acc = feature_bias_;
+            break;
+    }
+}
+
+std::int32_t NeuralNetwork::evaluate(const Accumulator& acc) const {
+    std::int32_t sum = 0;
+    int i = 0;
+#ifdef __AVX2__
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i top = _mm256_set1_epi16(ACTIVATION_MAX);
+    const __m256i ones = _mm256_set1_epi16(1);
+    __m256i total = _mm256_setzero_si256();
+    for (; i < HIDDEN; i += 32) {
+        __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc.values + i));
+        __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc.values + i + 16));
+        low = _mm256_min_epi16(_mm256_max_epi16(low, zero), top);
+        high = _mm256_min_epi16(_mm256_max_epi16(high, zero), top);
+        // packus interleaves the 128-bit halves; the permute puts the 32 activations back in order
+        __m256i active = _mm256_permute4x64_epi64(_mm256_packus_epi16(low, high), 0xD8);
+        __m256i weights = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(output_weights_ + i));
+        // u8 x i8 pairs fit in int16 (2 * 127 * 128 < 32768), then pairs of those widen to int32
+        __m256i products = _mm256_madd_epi16(_mm256_maddubs_epi16(active, weights), ones);
+        total = _mm256_add_epi32(total, products);
+    }
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    sum = _mm_cvtsi128_si32(half);
+#endif
+    for (; i < HIDDEN; i++) {
+        int active = acc.values[i] < 0 ? 0 : (acc.values[i] > ACTIVATION_MAX ? ACTIVATION_MAX : acc.values[i]);
+        sum += active * output_weights_[i];
+    }
+    return (sum + output_bias_) >> output_shift_;
+}
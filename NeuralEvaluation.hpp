@@ -0,0 +1,124 @@
+// File: NeuralEvaluation.hpp
+// Date: 10/18/26
+// A small quantized neural evaluator with an incrementally updated first layer
+
+#ifndef NEURAL_EVALUATION_HPP
+#define NEURAL_EVALUATION_HPP
+
+#include "Board.hpp"
+#include "ChangeFeed.hpp"
+#include "PackedPiece.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Weight file layout (little-endian, no padding):
+ *      "CBNN", uint32 version, uint32 features, uint32 hidden, uint32 output shift
+ *      int16   feature_bias[hidden]
+ *      int16   feature_weights[features][hidden]   One row per feature
+ *      int8    output_weights[hidden]
+ *      int32   output_bias
+ * features and hidden must match NeuralNetwork::FEATURES and NeuralNetwork::HIDDEN.
+ */
+const std::uint32_t NEURAL_NETWORK_VERSION = 1;
+
+/**
+ * @brief A two-layer network scored from SCORED_PLAYER's point of view, like Board::evaluation().
+ *      Inputs are one feature per (piece kind, square), a piece kind being a PAWN or ROOK with
+ *      its direction and whether it belongs to SCORED_PLAYER. The first layer is a sum of int16
+ *      weight rows, one per piece on the board, kept in an Accumulator that moves only change
+ *      by a few rows. The output is clamp(accumulator, 0, 127) . output_weights (int8), plus the
+ *      bias, shifted right by the output shift.
+ *      The kernels use AVX2 int16 adds and u8 x i8 multiply-adds when compiled with it and a
+ *      scalar loop otherwise; both give the same scores (int16 sums wrap in both).
+ */
+class NeuralNetwork {
+    public:
+        static const int FEATURES = 8 * Board::SQUARES;     // 2 types x 2 directions x 2 owners x 64 squares
+        static const int HIDDEN = 256;                      // First-layer width, a multiple of 32
+        static const int ACTIVATION_MAX = 127;              // Clamp for the first layer's outputs
+
+        /**
+         * @brief The first-layer outputs for one position: feature bias plus the rows of its pieces.
+         *      Weight rows use the same type, so every row starts on a 32-byte boundary.
+         */
+        struct alignas(32) Accumulator {
+            std::int16_t values[HIDDEN];
+        };
+        static_assert(sizeof(Accumulator) == HIDDEN * sizeof(std::int16_t), "Weight rows are read straight from the file");
+
+    private:
+        Accumulator feature_bias_;                      // Where every accumulator starts
+        std::vector<Accumulator> feature_weights_;      // FEATURES rows, aligned like accumulators
+        alignas(32) std::int8_t output_weights_[HIDDEN];
+        std::int32_t output_bias_;
+        int output_shift_;                              // Right shift applied to the output sum
+
+        // Row of feature_weights_ for a feature
+        const std::int16_t* row(int feature) const { return feature_weights_[feature].values; }
+
+    public:
+        /**
+         * @brief Default constructor: all weights zero, so every position scores 0 until load()
+         */
+        NeuralNetwork();
+
+        /**
+         * @brief Reads the weights from a file in the layout above
+         * @return False (and the network is unchanged) if the file is missing, malformed,
+         *      or built for a different FEATURES/HIDDEN
+         */
+        bool load(const std::string& path);
+
+        /**
+         * @brief Writes the weights in the layout load() reads
+         */
+        bool save(const std::string& path) const;
+
+        /**
+         * @return The input feature of a piece standing on a square, or -1 for type NONE
+         */
+        static int featureIndex(const PackedPiece& piece, int square) {
+            if (piece.type() == PieceType::None) {
+                return -1;
+            }
+            return (scoreKey(piece) - 4) * Board::SQUARES + square;
+        }
+
+        /**
+         * @brief Builds an accumulator from scratch: the bias plus a row per piece on the board
+         */
+        void refresh(const Board& board, Accumulator& acc) const;
+
+        /**
+         * @brief Adds or removes a piece standing on a square. Type NONE does nothing.
+         */
+        void addPiece(Accumulator& acc, const PackedPiece& piece, int square) const;
+        void removePiece(Accumulator& acc, const PackedPiece& piece, int square) const;
+
+        /**
+         * @brief Writes the accumulator after a move into `after_acc` in one pass over the rows, so a
+         *      search can keep one accumulator per ply and unmake by returning to the parent's.
+         * @param before_acc The accumulator of the position before board.makeMove(move)
+         * @param undo What makeMove() returned
+         * @param board The board after the move
+         */
+        void applyMove(const Accumulator& before_acc, const Move& move, const Undo& undo,
+                       const Board& board, Accumulator& after_acc) const;
+
+        /**
+         * @brief Applies a ChessBox change (see ChessBox::setChangeFeed()). Records are scored with
+         *      their player index as the owner. Pieces off the board are ignored, and so are pieces
+         *      of type NONE, which is how the feed publishes anything but a PAWN or ROOK: the
+         *      network has no features for them. A Reset puts the accumulator back to the bias.
+         */
+        void apply(const ChangeRecord& record, Accumulator& acc) const;
+
+        /**
+         * @return The network's score for an accumulator
+         */
+        std::int32_t evaluate(const Accumulator& acc) const;
+};
+
+#endif
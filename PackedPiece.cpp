@@ -0,0 +1,80 @@
+// File: PackedPiece.cpp
+// Date: 10/18/26
+// Implementation of the PackedPiece class
+
+#include "PackedPiece.hpp"
+#include "ChessPiece.hpp"
+#include "Pawn.hpp"
+#include "Rook.hpp"
+#include <cstdlib>
+
+PieceType pieceTypeFromString(const std::string& type) {
+    if (type == "PAWN") {
+        return PieceType::Pawn;
+    } else if (type == "ROOK") {
+        return PieceType::Rook;
+    }
+    return PieceType::None;
+}
+
+const char* pieceTypeName(PieceType type) {
+    switch (type) {
+        case PieceType::Pawn: return "PAWN";
+        case PieceType::Rook: return "ROOK";
+        default:              return "NONE";
+    }
+}
+
+int pieceTypeSize(PieceType type) {
+    switch (type) {
+        case PieceType::Pawn: return 1;
+        case PieceType::Rook: return 2;
+        default:              return 0;
+    }
+}
+
+bool PackedPiece::fromPiece(const ChessPiece& piece, int color, PackedPiece& packed) {
+    PieceType type = pieceTypeFromString(piece.getType());
+    if (type == PieceType::None || piece.size() != pieceTypeSize(type)) {
+        return false;
+    }
+    packed = PackedPiece(type, color, piece.getRow(), piece.getColumn(), piece.isMovingUp(),
+                         false, type == PieceType::Rook ? 3 : 0);
+    return true;
+}
+
+PackedPiece PackedPiece::fromPiece(const Pawn& pawn, int color) {
+    return PackedPiece(PieceType::Pawn, color, pawn.getRow(), pawn.getColumn(),
+                       pawn.isMovingUp(), pawn.canDoubleJump());
+}
+
+PackedPiece PackedPiece::fromPiece(const Rook& rook, int color) {
+    return PackedPiece(PieceType::Rook, color, rook.getRow(), rook.getColumn(),
+                       rook.isMovingUp(), false, rook.getCastleMovesLeft());
+}
+
+ChessPiece PackedPiece::toChessPiece(const std::string& color) const {
+    return ChessPiece(color, row_, column_, isMovingUp(), size(), getType());
+}
+
+bool PackedPiece::canPromote() const {
+    if (type() != PieceType::Pawn) {
+        return false;
+    }
+    return isMovingUp() ? row_ == BOARD_LENGTH - 1 : row_ == 0;
+}
+
+bool PackedPiece::canCastle(const PackedPiece& piece) const {
+    if (type() != PieceType::Rook || castle_moves_ == 0) {
+        return false;
+    }
+    if (color_ != piece.color_ || !onBoard() || !piece.onBoard()) {
+        return false;
+    }
+    return row_ == piece.row_ && std::abs(column_ - piece.column_) <= 1;
+}
+
+bool PackedPiece::operator==(const PackedPiece& other) const {
+    return type_ == other.type_ && color_ == other.color_ && row_ == other.row_ &&
+           column_ == other.column_ && flags_ == other.flags_ && castle_moves_ == other.castle_moves_;
+}
@@ -0,0 +1,183 @@
+// File: PackedPiece.hpp
+// Date: 10/18/26
+// A compact, trivially copyable representation of a chess piece, used where
+// pieces are stored in bulk (mapped files, snapshots, boards)
+
+#ifndef PACKED_PIECE_HPP
+#define PACKED_PIECE_HPP
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+class ChessPiece;
+class Pawn;
+class Rook;
+
+// The piece types the project knows about, as stored in a PackedPiece
+enum class PieceType : std::uint8_t {
+    None = 0,
+    Pawn = 1,
+    Rook = 2
+};
+
+/**
+ * @brief Converts a type string ("PAWN", "ROOK", ...) to a PieceType
+ * @return The matching PieceType, or PieceType::None for anything else
+ */
+PieceType pieceTypeFromString(const std::string& type);
+
+/**
+ * @return The type string used by ChessPiece::getType() for the given PieceType
+ */
+const char* pieceTypeName(PieceType type);
+
+/**
+ * @return The size() a piece of the given type takes up in a box (PAWN 1, ROOK 2, NONE 0)
+ */
+int pieceTypeSize(PieceType type);
+
+/**
+ * @brief A 6-byte piece: type, player index, position, and the Pawn/Rook specific state.
+ *      Unlike ChessPiece it holds no strings, so arrays of it can be copied with memcpy,
+ *      written to disk as-is and mapped back in. The color is stored as a player index
+ *      (eg. 0 for a box's P1_COLOR_, 1 for P2_COLOR_); the owner maps it to a name.
+ */
+class PackedPiece {
+    private:
+        static const std::uint8_t MOVING_UP = 0x01;     // flags_ bit: the piece is moving up
+        static const std::uint8_t DOUBLE_JUMP = 0x02;   // flags_ bit: the pawn can double jump
+
+        std::uint8_t type_ = 0;           // A PieceType value
+        std::uint8_t color_ = 0;          // Player index
+        std::int8_t row_ = -1;            // 0-indexed row, -1 when off the board
+        std::int8_t column_ = -1;         // 0-indexed column, -1 when off the board
+        std::uint8_t flags_ = 0;          // MOVING_UP | DOUBLE_JUMP
+        std::uint8_t castle_moves_ = 0;   // Castle moves left (rooks only)
+
+    public:
+        static const int BOARD_LENGTH = 8;
+
+        /**
+         * @brief Default constructor: a NONE piece of player 0 that is not on the board
+         */
+        PackedPiece() = default;
+
+        /**
+         * @brief Parameterized constructor.
+         * @param type The PieceType of the piece
+         * @param color The player index of the piece
+         * @param row The 0-indexed row. Out-of-bounds rows or columns put BOTH at -1, as in ChessPiece
+         * @param col The 0-indexed column
+         * @param isMovingUp Whether the piece is moving up the board
+         * @param canDoubleJump Whether a pawn can double jump (ignored for other types)
+         * @param castleMoves Castle moves left for a rook, clamped to [0, 255] (ignored for other types)
+         */
+        PackedPiece(PieceType type, int color, int row = -1, int col = -1,
+                    bool isMovingUp = false, bool canDoubleJump = false, int castleMoves = 0) :
+            type_(static_cast<std::uint8_t>(type)),
+            color_(static_cast<std::uint8_t>(color)) {
+            setPosition(row, col);
+            setMovingUp(isMovingUp);
+            if (type == PieceType::Pawn) {
+                setDoubleJump(canDoubleJump);
+            } else if (type == PieceType::Rook) {
+                setCastleMovesLeft(castleMoves);
+            }
+        }
+
+        /**
+         * @brief Packs a ChessPiece. Only the base-class state is available,
+         *      so a ROOK gets the default 3 castle moves and a PAWN cannot double jump.
+         * @param piece The piece to pack
+         * @param color The player index to store for it
+         * @param packed Receives the packed piece
+         * @return False (and packed is unchanged) if the piece cannot be packed faithfully:
+         *      its type is not PAWN or ROOK, or its size() is not pieceTypeSize() of that type
+         */
+        static bool fromPiece(const ChessPiece& piece, int color, PackedPiece& packed);
+
+        // Packs a Pawn, keeping its double jump flag
+        static PackedPiece fromPiece(const Pawn& pawn, int color);
+
+        // Packs a Rook, keeping its castle moves
+        static PackedPiece fromPiece(const Rook& rook, int color);
+
+        /**
+         * @brief Rebuilds a ChessPiece with the given color name
+         */
+        ChessPiece toChessPiece(const std::string& color) const;
+
+        PieceType type() const { return static_cast<PieceType>(type_); }
+        int getColor() const { return color_; }
+        int getRow() const { return row_; }
+        int getColumn() const { return column_; }
+        bool isMovingUp() const { return flags_ & MOVING_UP; }
+        bool canDoubleJump() const { return flags_ & DOUBLE_JUMP; }
+        int getCastleMovesLeft() const { return castle_moves_; }
+        bool onBoard() const { return row_ >= 0 && column_ >= 0; }
+
+        /**
+         * @return The square index row * BOARD_LENGTH + column, or -1 when off the board
+         */
+        int square() const { return onBoard() ? row_ * BOARD_LENGTH + column_ : -1; }
+
+        /**
+         * @brief Moves the piece. Out-of-bounds values take it off the board (row and column -1).
+         */
+        void setPosition(int row, int col) {
+            // Same rule as the ChessPiece constructor: both in bounds, or both -1
+            if (row >= 0 && row < BOARD_LENGTH && col >= 0 && col < BOARD_LENGTH) {
+                row_ = static_cast<std::int8_t>(row);
+                column_ = static_cast<std::int8_t>(col);
+            } else {
+                row_ = -1;
+                column_ = -1;
+            }
+        }
+
+        void setMovingUp(bool flag) {
+            flags_ = flag ? (flags_ | MOVING_UP) : (flags_ & ~MOVING_UP);
+        }
+
+        void setDoubleJump(bool flag) {
+            flags_ = flag ? (flags_ | DOUBLE_JUMP) : (flags_ & ~DOUBLE_JUMP);
+        }
+
+        void setCastleMovesLeft(int moves) {
+            castle_moves_ = static_cast<std::uint8_t>(moves < 0 ? 0 : (moves > 255 ? 255 : moves));
+        }
+
+        void setType(PieceType type) { type_ = static_cast<std::uint8_t>(type); }
+
+        /**
+         * @return The type string, matching ChessPiece::getType() ("PAWN", "ROOK", "NONE")
+         */
+        const char* getType() const { return pieceTypeName(type()); }
+
+        /**
+         * @return The size this piece takes up in a box, matching ChessPiece::size()
+         */
+        int size() const { return pieceTypeSize(type()); }
+
+        /**
+         * @brief Same rule as Pawn::canPromote(): the pawn sits on the farthest row in its direction
+         * @return False for pieces that are not pawns
+         */
+        bool canPromote() const;
+
+        /**
+         * @brief Same rule as Rook::canCastle(): castle moves left, same color, both on the board,
+         *      same row and columns at most 1 apart
+         * @return False if this piece is not a rook
+         */
+        bool canCastle(const PackedPiece& piece) const;
+
+        bool operator==(const PackedPiece& other) const;
+        bool operator!=(const PackedPiece& other) const { return !(*this == other); }
+};
+
+static_assert(std::is_trivially_copyable<PackedPiece>::value, "PackedPiece must stay trivially copyable");
+static_assert(sizeof(PackedPiece) == 6, "PackedPiece layout is part of the on-disk formats");
+
+#endif
@@ -0,0 +1,99 @@
+// File: PawnStructure.cpp
+// Date: 10/18/26
+// Implementation of the pawn-structure evaluation and the PawnHashTable class
+
+#include "PawnStructure.hpp"
+
+// Bonus for a passed pawn by promotion distance (0 means it can already promote)
+static const std::int32_t PASSED_BONUS[Board::BOARD_LENGTH] = {150, 100, 60, 35, 20, 10, 5, 0};
+static const std::int32_t DOUBLED_PENALTY = 15;
+static const std::int32_t ISOLATED_PENALTY = 12;
+
+// Squares on a column and the columns either side of it
+static std::uint64_t columnSpan(int col) {
+    std::uint64_t column = 0x0101010101010101ULL << col;
+    std::uint64_t span = column;
+    if (col > 0) {
+        span |= column >> 1;
+    }
+    if (col < Board::BOARD_LENGTH - 1) {
+        span |= column << 1;
+    }
+    return span;
+}
+
+// Squares on rows strictly ahead of row, in the pawn's direction
+static std::uint64_t rowsAhead(int row, bool moving_up) {
+    if (moving_up) {
+        return row >= Board::BOARD_LENGTH - 1 ? 0 : ~std::uint64_t(0) << ((row + 1) * Board::BOARD_LENGTH);
+    }
+    return row <= 0 ? 0 : ~std::uint64_t(0) >> ((Board::BOARD_LENGTH - row) * Board::BOARD_LENGTH);
+}
+
+std::int32_t evaluatePawns(const Board& board) {
+    // Pawn masks per color
+    std::uint64_t pawns[2] = {0, 0};
+    for (int square = 0; square < Board::SQUARES; square++) {
+        const PackedPiece& piece = board.at(square);
+        if (piece.type() == PieceType::Pawn) {
+            pawns[piece.getColor() == SCORED_PLAYER ? 1 : 0] |= std::uint64_t(1) << square;
+        }
+    }
+
+    std::int32_t score = 0;
+    for (int square = 0; square < Board::SQUARES; square++) {
+        const PackedPiece& piece = board.at(square);
+        if (piece.type() != PieceType::Pawn) {
+            continue;
+        }
+        int own = piece.getColor() == SCORED_PLAYER ? 1 : 0;
+        int row = square / Board::BOARD_LENGTH;
+        int col = square % Board::BOARD_LENGTH;
+        std::uint64_t ahead = rowsAhead(row, piece.isMovingUp());
+        std::uint64_t column = 0x0101010101010101ULL << col;
+        std::uint64_t neighbors = columnSpan(col) & ~column;
+
+        std::int32_t value = 0;
+        if ((pawns[1 - own] & columnSpan(col) & ahead) == 0) {
+            int distance = piece.isMovingUp() ? Board::BOARD_LENGTH - 1 - row : row;
+            value += PASSED_BONUS[distance];
+        }
+        if (pawns[own] & column & ahead) {
+            value -= DOUBLED_PENALTY;
+        }
+        if ((pawns[own] & neighbors) == 0) {
+            value -= ISOLATED_PENALTY;
+        }
+        score += own ? value : -value;
+    }
+    return score;
+}
+
+PawnHashTable::PawnHashTable(std::size_t entries) : probes_(0), hits_(0) {
+    std::size_t size = 1;
+    while (size < entries) {
+        size *= 2;
+    }
+    entries_.assign(size, Entry{0, 0});
+    mask_ = size - 1;
+}
+
+void PawnHashTable::clear() {
+    entries_.assign(entries_.size(), Entry{0, 0});
+    resetStats();
+}
+
+PawnHashTable& threadPawnTable() {
+    static thread_local PawnHashTable table;
+    return table;
+}
+
+std::int32_t evaluatePawns(const Board& board, PawnHashTable& table) {
+    std::int32_t score;
+    if (table.probe(board.pawnKey(), score)) {
+        return score;
+    }
+    score = evaluatePawns(board);
+    table.store(board.pawnKey(), score);
+    return score;
+}
@@ -0,0 +1,97 @@
+// File: PawnStructure.hpp
+// Date: 10/18/26
+// Pawn-structure evaluation and a small hash table that caches it by pawn key
+
+#ifndef PAWN_STRUCTURE_HPP
+#define PAWN_STRUCTURE_HPP
+
+#include "Board.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Scores the pawns of a board from SCORED_PLAYER's point of view, like Board::evaluation():
+ *      - a passed pawn (no enemy pawn ahead of it, in its direction, on its own or an adjacent
+ *        column) earns a bonus that grows as its promotion distance shrinks, the distance being
+ *        the rows left until canPromote() would hold
+ *      - a doubled pawn (an own pawn further ahead on its column) and an isolated pawn (no own
+ *        pawn on either adjacent column) are penalized
+ *      The score depends only on the pawns, so it can be cached under Board::pawnKey().
+ */
+std::int32_t evaluatePawns(const Board& board);
+
+/**
+ * @brief A direct-mapped cache of evaluatePawns() scores keyed by Board::pawnKey(), meant to be
+ *      owned by one search thread (threadPawnTable()), so probes take no locks. A new entry
+ *      overwrites whatever shared its slot. Empty slots hold key 0 with score 0, which is the
+ *      right answer for a board without pawns.
+ */
+class PawnHashTable {
+    private:
+        struct Entry {
+            std::uint64_t key;      // Board::pawnKey() of the cached structure
+            std::int32_t score;     // evaluatePawns() for it
+        };
+
+        std::vector<Entry> entries_;    // A power of 2 entries
+        std::size_t mask_;              // entries_.size() - 1
+        std::uint64_t probes_;          // Lookups since the last clear() or resetStats()
+        std::uint64_t hits_;            // Lookups that found their key
+
+    public:
+        /**
+         * @param entries Number of slots, rounded up to a power of 2 (at least 1)
+         */
+        explicit PawnHashTable(std::size_t entries = 16384);
+
+        /**
+         * @brief Looks up a pawn key, counting the probe
+         * @return True (and score is set) on a hit
+         */
+        bool probe(std::uint64_t key, std::int32_t& score) {
+            const Entry& entry = entries_[key & mask_];
+            probes_++;
+            if (entry.key != key) {
+                return false;
+            }
+            hits_++;
+            score = entry.score;
+            return true;
+        }
+
+        void store(std::uint64_t key, std::int32_t score) {
+            Entry& entry = entries_[key & mask_];
+            entry.key = key;
+            entry.score = score;
+        }
+
+        /**
+         * @brief Empties every slot and resets the statistics
+         */
+        void clear();
+
+        void resetStats() { probes_ = 0; hits_ = 0; }
+        std::uint64_t probes() const { return probes_; }
+        std::uint64_t hits() const { return hits_; }
+
+        /**
+         * @return hits() / probes(), or 0 before the first probe
+         */
+        double hitRate() const { return probes_ == 0 ? 0.0 : static_cast<double>(hits_) / static_cast<double>(probes_); }
+
+        std::size_t size() const { return entries_.size(); }
+};
+
+/**
+ * @return The calling thread's own PawnHashTable, created with the default size on first use
+ */
+PawnHashTable& threadPawnTable();
+
+/**
+ * @brief evaluatePawns() through a cache: probes the table with board.pawnKey() and only
+ *      evaluates (and stores the result) on a miss
+ */
+std::int32_t evaluatePawns(const Board& board, PawnHashTable& table);
+
+#endif
@@ -0,0 +1,117 @@
+// File: PersistentLinkedBox.cpp
+// Date: 10/18/26
+// Implementation of the PersistentLinkedBox template class
+
+#ifndef PERSISTENT_LINKED_BOX_CPP_
+#define PERSISTENT_LINKED_BOX_CPP_
+
+#include "PersistentLinkedBox.hpp"
+#include <utility>
+
+template <typename T>
+typename PersistentLinkedBox<T>::Node* PersistentLinkedBox<T>::acquire(Node* node) {
+    if (node != nullptr) {
+        node->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    return node;
+}
+
+template <typename T>
+void PersistentLinkedBox<T>::release(Node* node) {
+    // A long chain must not be freed recursively; each freed node hands its reference
+    // to the next one, and the walk stops at the first node still used elsewhere
+    while (node != nullptr && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        Node* next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+template <typename T>
+PersistentLinkedBox<T>::PersistentLinkedBox() : head_(nullptr), size_(0), capacity_(64) {
+}
+
+template <typename T>
+PersistentLinkedBox<T>::PersistentLinkedBox(const int& capacity) : head_(nullptr), size_(0) {
+    capacity_ = (capacity <= 0) ? 64 : capacity;
+}
+
+template <typename T>
+PersistentLinkedBox<T>::PersistentLinkedBox(const PersistentLinkedBox& other) :
+    head_(acquire(other.head_)), size_(other.size_), capacity_(other.capacity_) {
+}
+
+template <typename T>
+PersistentLinkedBox<T>::PersistentLinkedBox(PersistentLinkedBox&& other) noexcept :
+    head_(other.head_), size_(other.size_), capacity_(other.capacity_) {
+    other.head_ = nullptr;
+    other.size_ = 0;
+}
+
+template <typename T>
+PersistentLinkedBox<T>& PersistentLinkedBox<T>::operator=(PersistentLinkedBox other) noexcept {
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+    return *this;
+}
+
+template <typename T>
+PersistentLinkedBox<T>::~PersistentLinkedBox() {
+    release(head_);
+}
+
+template <typename T>
+bool PersistentLinkedBox<T>::addItem(const T& target, PersistentLinkedBox& result) const {
+    if (size_ + target.size() > capacity_) {
+        return false;
+    }
+    Node* head = new Node(target, acquire(head_));
+    result = PersistentLinkedBox(head, size_ + target.size(), capacity_);
+    return true;
+}
+
+template <typename T>
+bool PersistentLinkedBox<T>::remove(const std::string& type, PersistentLinkedBox& result) const {
+    Node* victim = head_;
+    while (victim != nullptr && victim->value.getType() != type) {
+        victim = victim->next;
+    }
+    if (victim == nullptr) {
+        return false;
+    }
+
+    // Copy the prefix; the copies' reference counts start at 1 for the pointer to them
+    Node* head = nullptr;
+    Node** link = &head;
+    for (Node* node = head_; node != victim; node = node->next) {
+        *link = new Node(node->value, nullptr);
+        link = &(*link)->next;
+    }
+    *link = acquire(victim->next);
+    result = PersistentLinkedBox(head, size_ - victim->value.size(), capacity_);
+    return true;
+}
+
+template <typename T>
+bool PersistentLinkedBox<T>::contains(const std::string& type) const {
+    for (const Node* node = head_; node != nullptr; node = node->next) {
+        if (node->value.getType() == type) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+int PersistentLinkedBox<T>::count(const std::string& type) const {
+    int count = 0;
+    for (const Node* node = head_; node != nullptr; node = node->next) {
+        if (node->value.getType() == type) {
+            count++;
+        }
+    }
+    return count;
+}
+
+#endif
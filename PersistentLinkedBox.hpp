@@ -0,0 +1,111 @@
+// File: PersistentLinkedBox.hpp
+// Date: 10/18/26
+// An immutable, reference-counted LinkedBox whose versions share their tails
+
+#ifndef PERSISTENT_LINKED_BOX_HPP_
+#define PERSISTENT_LINKED_BOX_HPP_
+
+#include <atomic>
+#include <string>
+
+/**
+ * @brief A LinkedBox that is never modified in place. Since LinkedBox inserts at the head,
+ *      every version can share the rest of the chain with the version it came from:
+ *      - addItem builds a new version in O(1): one new node pointing at the old head
+ *      - remove copies only the nodes in front of the removed one and shares the rest
+ *      - copying a box (a snapshot) copies a pointer and bumps one reference count
+ *      Nodes carry an intrusive atomic reference count (one per version head or node pointing
+ *      at them), so versions can be handed to other threads and released from any of them.
+ */
+template <typename T>
+class PersistentLinkedBox {
+    private:
+        struct Node {
+            T value;                    // The stored item
+            Node* next;                 // Next (older) node, shared between versions
+            std::atomic<int> refs;      // Versions and nodes pointing at this node
+
+            Node(const T& item, Node* next_node) : value(item), next(next_node), refs(1) {}
+        };
+
+        Node* head_;        // Newest node; this box owns one reference to it
+        int size_;          // Total size of the items
+        int capacity_;      // Maximum capacity
+
+        // Adopts a chain whose head reference is already counted for this box
+        PersistentLinkedBox(Node* head, int size, int capacity) : head_(head), size_(size), capacity_(capacity) {}
+
+        static Node* acquire(Node* node);
+
+        // Drops one reference, freeing the nodes that become unreferenced without recursion
+        static void release(Node* node);
+
+    public:
+        /**
+         * @brief Default constructor: an empty box with capacity 64
+         */
+        PersistentLinkedBox();
+
+        /**
+         * @brief Parameterized constructor
+         * @param capacity The capacity of the box
+         * @note If the capacity is 0 or negative, 64 is used instead
+         */
+        PersistentLinkedBox(const int& capacity);
+
+        /**
+         * @brief Snapshot: shares the whole chain with `other`. O(1).
+         */
+        PersistentLinkedBox(const PersistentLinkedBox& other);
+        PersistentLinkedBox(PersistentLinkedBox&& other) noexcept;
+        PersistentLinkedBox& operator=(PersistentLinkedBox other) noexcept;
+
+        ~PersistentLinkedBox();
+
+        int size() const { return size_; }
+        int capacity() const { return capacity_; }
+        bool empty() const { return head_ == nullptr; }
+
+        /**
+         * @brief Builds the version with `target` inserted at the head, sharing this version's chain. O(1).
+         * @param result Receives the new version; it may be this box itself
+         * @return True if the item fit in the capacity. False otherwise (result is unchanged).
+         */
+        bool addItem(const T& target, PersistentLinkedBox& result) const;
+
+        /**
+         * @brief Builds the version without the first (newest) item of the given type. Only the
+         *      nodes in front of it are copied; everything after it is shared.
+         * @param result Receives the new version; it may be this box itself
+         * @return True if an item was removed. False otherwise (result is unchanged).
+         */
+        bool remove(const std::string& type, PersistentLinkedBox& result) const;
+
+        /**
+         * @return True if an item of the given type is in this version
+         */
+        bool contains(const std::string& type) const;
+
+        /**
+         * @return The number of items of the given type in this version
+         */
+        int count(const std::string& type) const;
+
+        /**
+         * @brief Calls visit(item) for each item, newest first
+         */
+        template <typename Visitor>
+        void forEach(Visitor visit) const {
+            for (const Node* node = head_; node != nullptr; node = node->next) {
+                visit(node->value);
+            }
+        }
+
+        /**
+         * @return True if both versions start with the same node (eg. one is a snapshot of the other)
+         */
+        bool sharesHeadWith(const PersistentLinkedBox& other) const { return head_ == other.head_; }
+};
+
+#include "PersistentLinkedBox.cpp"
+#endif // PERSISTENT_LINKED_BOX_HPP_
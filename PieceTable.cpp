@@ -0,0 +1,166 @@
+// File: PieceTable.cpp
+// Date: 10/18/26
+// Implementation of the PieceTable class
+
+#include "PieceTable.hpp"
+#include <cstdlib>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+static const std::uint8_t PAWN = static_cast<std::uint8_t>(PieceType::Pawn);
+static const std::uint8_t ROOK = static_cast<std::uint8_t>(PieceType::Rook);
+
+// The columns a castle kernel reads for one side
+struct CastleColumns {
+    const std::uint8_t* types;
+    const std::uint8_t* colors;
+    const std::int8_t* rows;
+    const std::int8_t* columns;
+    const std::uint8_t* castle_moves;
+};
+
+// Sets bit i of a mask
+static void setBit(PieceTable::Mask& out, std::size_t i) {
+    out[i / 64] |= std::uint64_t(1) << (i % 64);
+}
+
+// Scalar canCastle() on row i of the rooks and row j of the partners
+static bool castleAt(const CastleColumns& rook, std::size_t i, const CastleColumns& partner, std::size_t j) {
+    return rook.types[i] == ROOK && rook.castle_moves[i] != 0 && rook.colors[i] == partner.colors[j] &&
+           rook.rows[i] >= 0 && partner.rows[j] >= 0 && rook.rows[i] == partner.rows[j] &&
+           std::abs(rook.columns[i] - partner.columns[j]) <= 1;
+}
+
+// partner_step is 1 to walk the partners with the rooks, 0 to compare every rook with row 0
+static void castleKernel(const CastleColumns& rook, const CastleColumns& partner, std::size_t partner_step,
+                         std::size_t count, PieceTable::Mask& out) {
+    out.assign((count + 63) / 64, 0);
+    std::size_t i = 0;
+#ifdef __AVX2__
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i two = _mm256_set1_epi8(2);
+    const __m256i rook_type = _mm256_set1_epi8(static_cast<char>(ROOK));
+    auto load = [](const void* p) { return _mm256_loadu_si256(static_cast<const __m256i*>(p)); };
+    auto partnerLoad = [&](const void* base, std::size_t index) {
+        return partner_step ? load(static_cast<const std::uint8_t*>(base) + index)
+                            : _mm256_set1_epi8(*static_cast<const char*>(base));
+    };
+    for (; i + 32 <= count; i += 32) {
+        __m256i rows = load(rook.rows + i);
+        __m256i partner_rows = partnerLoad(partner.rows, i);
+        __m256i hit = _mm256_cmpeq_epi8(load(rook.types + i), rook_type);
+        hit = _mm256_andnot_si256(_mm256_cmpeq_epi8(load(rook.castle_moves + i), zero), hit);
+        hit = _mm256_and_si256(hit, _mm256_cmpeq_epi8(load(rook.colors + i), partnerLoad(partner.colors, i)));
+        // Same row, and that row is on the board (off-board rows are -1)
+        hit = _mm256_and_si256(hit, _mm256_cmpeq_epi8(rows, partner_rows));
+        hit = _mm256_andnot_si256(_mm256_cmpgt_epi8(zero, rows), hit);
+        __m256i distance = _mm256_abs_epi8(_mm256_sub_epi8(load(rook.columns + i), partnerLoad(partner.columns, i)));
+        hit = _mm256_and_si256(hit, _mm256_cmpgt_epi8(two, distance));
+        std::uint64_t bits = static_cast<std::uint32_t>(_mm256_movemask_epi8(hit));
+        out[i / 64] |= bits << (i % 64);
+    }
+#endif
+    for (; i < count; i++) {
+        if (castleAt(rook, i, partner, i * partner_step)) {
+            setBit(out, i);
+        }
+    }
+}
+
+static CastleColumns castleColumns(const std::vector<std::uint8_t>& types, const std::vector<std::uint8_t>& colors,
+                                   const std::vector<std::int8_t>& rows, const std::vector<std::int8_t>& columns,
+                                   const std::vector<std::uint8_t>& castle_moves) {
+    return CastleColumns{types.data(), colors.data(), rows.data(), columns.data(), castle_moves.data()};
+}
+
+void PieceTable::reserve(std::size_t pieces) {
+    types_.reserve(pieces);
+    colors_.reserve(pieces);
+    rows_.reserve(pieces);
+    columns_.reserve(pieces);
+    moving_up_.reserve(pieces);
+    double_jump_.reserve(pieces);
+    castle_moves_.reserve(pieces);
+}
+
+void PieceTable::clear() {
+    types_.clear();
+    colors_.clear();
+    rows_.clear();
+    columns_.clear();
+    moving_up_.clear();
+    double_jump_.clear();
+    castle_moves_.clear();
+}
+
+void PieceTable::add(const PackedPiece& piece) {
+    types_.push_back(static_cast<std::uint8_t>(piece.type()));
+    colors_.push_back(static_cast<std::uint8_t>(piece.getColor()));
+    rows_.push_back(static_cast<std::int8_t>(piece.getRow()));
+    columns_.push_back(static_cast<std::int8_t>(piece.getColumn()));
+    moving_up_.push_back(piece.isMovingUp() ? 1 : 0);
+    double_jump_.push_back(piece.canDoubleJump() ? 1 : 0);
+    castle_moves_.push_back(static_cast<std::uint8_t>(piece.getCastleMovesLeft()));
+}
+
+PackedPiece PieceTable::piece(std::size_t i) const {
+    return PackedPiece(static_cast<PieceType>(types_[i]), colors_[i], rows_[i], columns_[i],
+                       moving_up_[i] != 0, double_jump_[i] != 0, castle_moves_[i]);
+}
+
+void PieceTable::promotionMask(Mask& out) const {
+    std::size_t count = size();
+    out.assign((count + 63) / 64, 0);
+    std::size_t i = 0;
+#ifdef __AVX2__
+    const __m256i pawn = _mm256_set1_epi8(static_cast<char>(PAWN));
+    const __m256i last_row = _mm256_set1_epi8(PackedPiece::BOARD_LENGTH - 1);
+    const __m256i one = _mm256_set1_epi8(1);
+    for (; i + 32 <= count; i += 32) {
+        __m256i types = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(types_.data() + i));
+        __m256i rows = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows_.data() + i));
+        __m256i up = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(moving_up_.data() + i));
+        // The last row is BOARD_LENGTH - 1 moving up and 0 moving down
+        __m256i target = _mm256_and_si256(_mm256_cmpeq_epi8(up, one), last_row);
+        __m256i hit = _mm256_and_si256(_mm256_cmpeq_epi8(types, pawn), _mm256_cmpeq_epi8(rows, target));
+        std::uint64_t bits = static_cast<std::uint32_t>(_mm256_movemask_epi8(hit));
+        out[i / 64] |= bits << (i % 64);
+    }
+#endif
+    for (; i < count; i++) {
+        int last = moving_up_[i] ? PackedPiece::BOARD_LENGTH - 1 : 0;
+        if (types_[i] == PAWN && rows_[i] == last) {
+            setBit(out, i);
+        }
+    }
+}
+
+bool PieceTable::castleMask(const PieceTable& partners, Mask& out) const {
+    if (partners.size() != size()) {
+        return false;
+    }
+    castleKernel(castleColumns(types_, colors_, rows_, columns_, castle_moves_),
+                 castleColumns(partners.types_, partners.colors_, partners.rows_, partners.columns_,
+                               partners.castle_moves_),
+                 1, size(), out);
+    return true;
+}
+
+void PieceTable::castleMask(const PackedPiece& partner, Mask& out) const {
+    std::uint8_t type = static_cast<std::uint8_t>(partner.type());
+    std::uint8_t color = static_cast<std::uint8_t>(partner.getColor());
+    std::int8_t row = static_cast<std::int8_t>(partner.getRow());
+    std::int8_t column = static_cast<std::int8_t>(partner.getColumn());
+    std::uint8_t castle_moves = static_cast<std::uint8_t>(partner.getCastleMovesLeft());
+    castleKernel(castleColumns(types_, colors_, rows_, columns_, castle_moves_),
+                 CastleColumns{&type, &color, &row, &column, &castle_moves}, 0, size(), out);
+}
+
+std::size_t PieceTable::countBits(const Mask& mask) {
+    std::size_t count = 0;
+    for (std::uint64_t word : mask) {
+        count += static_cast<std::size_t>(__builtin_popcountll(word));
+    }
+    return count;
+}
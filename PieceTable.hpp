@@ -0,0 +1,74 @@
+// File: PieceTable.hpp
+// Date: 10/18/26
+// A structure-of-arrays table of pieces with batch promotion and castling kernels
+
+#ifndef PIECE_TABLE_HPP
+#define PIECE_TABLE_HPP
+
+#include "PackedPiece.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Pieces from any number of positions stored column-wise: one array per field, so a
+ *      predicate over millions of pieces streams through a few byte arrays instead of
+ *      ChessPiece objects. Results are bitmasks with bit i (word i / 64, bit i % 64) for row i.
+ *      The kernels use AVX2 (32 rows per step) when compiled with it and a scalar loop otherwise;
+ *      both give the same answers as PackedPiece::canPromote() and PackedPiece::canCastle().
+ */
+class PieceTable {
+    private:
+        std::vector<std::uint8_t> types_;           // PieceType values
+        std::vector<std::uint8_t> colors_;          // Player indices
+        std::vector<std::int8_t> rows_;             // 0-indexed rows, -1 when off the board
+        std::vector<std::int8_t> columns_;          // 0-indexed columns, -1 when off the board
+        std::vector<std::uint8_t> moving_up_;       // 1 if the piece is moving up, else 0
+        std::vector<std::uint8_t> double_jump_;     // 1 if the pawn can double jump, else 0
+        std::vector<std::uint8_t> castle_moves_;    // Castle moves left (rooks only)
+
+    public:
+        // A bitmask with one bit per row of a table
+        typedef std::vector<std::uint64_t> Mask;
+
+        std::size_t size() const { return types_.size(); }
+        void reserve(std::size_t pieces);
+        void clear();
+
+        /**
+         * @brief Appends a piece as the next row
+         */
+        void add(const PackedPiece& piece);
+
+        /**
+         * @return Row i as a PackedPiece
+         */
+        PackedPiece piece(std::size_t i) const;
+
+        /**
+         * @brief Evaluates canPromote() for every row
+         * @param out Resized to (size() + 63) / 64 words; bit i is set if row i is a pawn on its last row
+         */
+        void promotionMask(Mask& out) const;
+
+        /**
+         * @brief Evaluates row i's canCastle(partners row i) for every row, eg. each rook of a
+         *      batch of positions against the piece next to it in the same position
+         * @param partners A table with the same number of rows
+         * @param out Resized to (size() + 63) / 64 words
+         * @return False (and out is untouched) if the sizes differ
+         */
+        bool castleMask(const PieceTable& partners, Mask& out) const;
+
+        /**
+         * @brief Evaluates canCastle(partner) for every row against one piece
+         */
+        void castleMask(const PackedPiece& partner, Mask& out) const;
+
+        /**
+         * @return The number of bits set in a mask
+         */
+        static std::size_t countBits(const Mask& mask);
+};
+
+#endif
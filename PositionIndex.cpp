@@ -0,0 +1,235 @@
+// File: PositionIndex.cpp
+// Date: 10/18/26
+// Implementation of the PositionIndex class
+
+#include "PositionIndex.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+static const char POSITION_INDEX_MAGIC[4] = { 'C', 'B', 'P', 'I' };
+static const std::uint32_t POSITION_INDEX_VERSION = 1;
+
+PositionIndex::PositionIndex() : positions_(0) {
+}
+
+int PositionIndex::listIndex(int player, PieceType type, int square) {
+    if (player < 0 || player >= PLAYERS || square < 0 || square >= Board::SQUARES) {
+        return -1;
+    }
+    int kind = static_cast<int>(type) - static_cast<int>(PieceType::Pawn);
+    if (kind < 0 || kind >= TYPES) {
+        return -1;
+    }
+    return (player * TYPES + kind) * Board::SQUARES + square;
+}
+
+std::uint32_t PositionIndex::addPosition(const Board& board) {
+    std::uint32_t id = positions_++;
+    for (int square = 0; square < Board::SQUARES; square++) {
+        const PackedPiece& piece = board.at(square);
+        if (piece.type() == PieceType::None) {
+            continue;
+        }
+        int list = listIndex(piece.getColor(), piece.type(), square);
+        if (list != -1) {
+            lists_[list].add(id);
+        }
+    }
+    return id;
+}
+
+std::size_t PositionIndex::addGames(GameDecoder& decoder) {
+    Board board;
+    EncodedGame game;
+    std::size_t games = 0;
+    while (decoder.next(game)) {
+        if (!parseFen(game.fen.empty() ? std::string_view(START_FEN) : game.fen, board)) {
+            continue;
+        }
+        beginGame();
+        addPosition(board);
+        for (std::uint32_t i = 0; i < game.move_count; i++) {
+            board.makeMove(game.move(i));
+            addPosition(board);
+        }
+        games++;
+    }
+    return games;
+}
+
+const RoaringBitmap& PositionIndex::postings(int player, PieceType type, int square) const {
+    static const RoaringBitmap EMPTY;
+    int list = listIndex(player, type, square);
+    return (list == -1) ? EMPTY : lists_[list];
+}
+
+bool PositionIndex::locate(std::uint32_t position, std::size_t& game, std::uint32_t& ply) const {
+    if (position >= positions_ || game_starts_.empty() || position < game_starts_.front()) {
+        return false;
+    }
+    // The last game starting at or before the position
+    std::vector<std::uint32_t>::const_iterator it = std::upper_bound(game_starts_.begin(), game_starts_.end(), position) - 1;
+    game = static_cast<std::size_t>(it - game_starts_.begin());
+    ply = position - *it;
+    return true;
+}
+
+RoaringBitmap PositionIndex::rooksSharingRow(int player) const {
+    // Squares are numbered row by row, so each row's lists are one group of BOARD_LENGTH
+    const RoaringBitmap* rooks[Board::SQUARES];
+    for (int square = 0; square < Board::SQUARES; square++) {
+        rooks[square] = &postings(player, PieceType::Rook, square);
+    }
+    return RoaringBitmap::atLeastTwo(rooks, Board::SQUARES, Board::BOARD_LENGTH);
+}
+
+RoaringBitmap PositionIndex::pawnsNearPromotion(int player) const {
+    int row = (player == Board::WHITE_PLAYER) ? Board::BOARD_LENGTH - 2 : 1;
+    RoaringBitmap result;
+    for (int col = 0; col < Board::BOARD_LENGTH; col++) {
+        result = RoaringBitmap::unite(result, postings(player, PieceType::Pawn, row * Board::BOARD_LENGTH + col));
+    }
+    return result;
+}
+
+bool PositionIndex::save(const std::string& path) const {
+    // Layout: magic, version, position count, game count, game start ids, then each posting list
+    std::vector<char> out(POSITION_INDEX_MAGIC, POSITION_INDEX_MAGIC + sizeof(POSITION_INDEX_MAGIC));
+    std::uint32_t header[3] = { POSITION_INDEX_VERSION, positions_, static_cast<std::uint32_t>(game_starts_.size()) };
+    out.insert(out.end(), reinterpret_cast<const char*>(header), reinterpret_cast<const char*>(header) + sizeof(header));
+    const char* starts = reinterpret_cast<const char*>(game_starts_.data());
+    out.insert(out.end(), starts, starts + game_starts_.size() * sizeof(std::uint32_t));
+    for (const RoaringBitmap& list : lists_) {
+        list.write(out);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(file);
+}
+
+bool PositionIndex::load(const std::string& path) {
+    clear();
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const char* cursor = data.data();
+    const char* end = data.data() + data.size();
+
+    std::uint32_t header[3];
+    if (data.size() < sizeof(POSITION_INDEX_MAGIC) + sizeof(header) ||
+        std::memcmp(cursor, POSITION_INDEX_MAGIC, sizeof(POSITION_INDEX_MAGIC)) != 0) {
+        return false;
+    }
+    cursor += sizeof(POSITION_INDEX_MAGIC);
+    std::memcpy(header, cursor, sizeof(header));
+    cursor += sizeof(header);
+    if (header[0] != POSITION_INDEX_VERSION || static_cast<std::size_t>(end - cursor) / sizeof(std::uint32_t) < header[2]) {
+        return false;
+    }
+
+    game_starts_.resize(header[2]);
+    std::memcpy(game_starts_.data(), cursor, header[2] * sizeof(std::uint32_t));
+    cursor += header[2] * sizeof(std::uint32_t);
+    for (RoaringBitmap& list : lists_) {
+        if (!list.read(cursor, end)) {
+            clear();
+            return false;
+        }
+    }
+    if (cursor != end) {
+        clear();
+        return false;
+    }
+
+    // Games start in order, no later than the end of the index (a game begun last may have
+    // no positions yet), and every posting names a position that exists
+    bool valid = true;
+    for (std::size_t game = 0; valid && game < game_starts_.size(); game++) {
+        valid = game_starts_[game] <= header[1] && (game == 0 || game_starts_[game - 1] <= game_starts_[game]);
+    }
+    for (const RoaringBitmap& list : lists_) {
+        valid = valid && (list.empty() || list.maximum() < header[1]);
+    }
+    if (!valid) {
+        clear();
+        return false;
+    }
+    positions_ = header[1];
+    return true;
+}
+
+void PositionIndex::clear() {
+    for (RoaringBitmap& list : lists_) {
+        list.clear();
+    }
+    positions_ = 0;
+    game_starts_.clear();
+}
+
+bool checkPositionIndex(const PositionIndex& index, GameDecoder& decoder) {
+    RoaringBitmap rook_rows[PositionIndex::PLAYERS];
+    RoaringBitmap near_promotion[PositionIndex::PLAYERS];
+    for (int player = 0; player < PositionIndex::PLAYERS; player++) {
+        rook_rows[player] = index.rooksSharingRow(player);
+        near_promotion[player] = index.pawnsNearPromotion(player);
+    }
+
+    // Replays the games the way addGames() does and checks each position by scanning its board
+    std::uint32_t id = 0;
+    std::size_t games = 0;
+    bool consistent = true;
+    auto check = [&](const Board& board) {
+        for (int player = 0; player < PositionIndex::PLAYERS; player++) {
+            bool shared_row = false;
+            for (int row = 0; row < Board::BOARD_LENGTH; row++) {
+                int rooks = 0;
+                for (int col = 0; col < Board::BOARD_LENGTH; col++) {
+                    const PackedPiece& piece = board.at(row * Board::BOARD_LENGTH + col);
+                    rooks += piece.type() == PieceType::Rook && piece.getColor() == player;
+                }
+                shared_row = shared_row || rooks >= 2;
+            }
+            int pawn_row = (player == Board::WHITE_PLAYER) ? Board::BOARD_LENGTH - 2 : 1;
+            bool near = false;
+            for (int col = 0; col < Board::BOARD_LENGTH; col++) {
+                const PackedPiece& piece = board.at(pawn_row * Board::BOARD_LENGTH + col);
+                near = near || (piece.type() == PieceType::Pawn && piece.getColor() == player);
+            }
+            consistent = consistent && rook_rows[player].contains(id) == shared_row &&
+                         near_promotion[player].contains(id) == near;
+        }
+        for (int square = 0; square < Board::SQUARES; square++) {
+            const PackedPiece& piece = board.at(square);
+            for (int player = 0; player < PositionIndex::PLAYERS; player++) {
+                for (PieceType type : { PieceType::Pawn, PieceType::Rook }) {
+                    bool here = piece.type() == type && piece.getColor() == player;
+                    consistent = consistent && index.postings(player, type, square).contains(id) == here;
+                }
+            }
+        }
+        std::size_t game;
+        std::uint32_t ply;
+        consistent = consistent && index.locate(id, game, ply) && game == games - 1;
+        id++;
+    };
+
+    Board board;
+    EncodedGame game;
+    while (consistent && decoder.next(game)) {
+        if (!parseFen(game.fen.empty() ? std::string_view(START_FEN) : game.fen, board)) {
+            continue;
+        }
+        games++;
+        check(board);
+        for (std::uint32_t i = 0; consistent && i < game.move_count; i++) {
+            board.makeMove(game.move(i));
+            check(board);
+        }
+    }
+    return consistent && id == index.positionCount() && games == index.gameCount();
+}
@@ -0,0 +1,117 @@
+// File: PositionIndex.hpp
+// Date: 10/18/26
+// An inverted index over every position of a game database: one posting list of
+// position ids per (player, piece type, square), stored as RoaringBitmaps
+
+#ifndef POSITION_INDEX_HPP
+#define POSITION_INDEX_HPP
+
+#include "Board.hpp"
+#include "GameCodec.hpp"
+#include "RoaringBitmap.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Position ids are numbered from 0 in indexing order; each game contributes its
+ *      start position and the position after every move. A query intersects and merges
+ *      posting lists instead of replaying games, then locate() maps the matching ids back
+ *      to (game, ply).
+ *
+ * Example: positions where WHITE has two rooks on one row and a pawn one step from promotion
+ *      RoaringBitmap hits = RoaringBitmap::intersect(index.rooksSharingRow(Board::WHITE_PLAYER),
+ *                                                    index.pawnsNearPromotion(Board::WHITE_PLAYER));
+ */
+class PositionIndex {
+    public:
+        static const int PLAYERS = 2;
+        static const int TYPES = 2;     // Pawn and Rook
+        static const int LISTS = PLAYERS * TYPES * Board::SQUARES;
+
+    private:
+        RoaringBitmap lists_[LISTS];            // Posting lists, see listIndex()
+        std::uint32_t positions_;               // Positions indexed so far
+        std::vector<std::uint32_t> game_starts_; // Id of each game's start position
+
+        // Index of the posting list for a piece, or -1 if it has no list
+        static int listIndex(int player, PieceType type, int square);
+
+    public:
+        /**
+         * @brief Default constructor: an empty index
+         */
+        PositionIndex();
+
+        /**
+         * @brief Adds a position, giving it the next id
+         * @return The position's id
+         */
+        std::uint32_t addPosition(const Board& board);
+
+        /**
+         * @brief Marks the next position added as the start of a new game
+         */
+        void beginGame() { game_starts_.push_back(positions_); }
+
+        /**
+         * @brief Indexes every remaining game of an encoded stream, position by position
+         * @return The number of games indexed. Games whose start position is invalid are skipped.
+         */
+        std::size_t addGames(GameDecoder& decoder);
+
+        /**
+         * @return The posting list for a piece (empty for types that have none)
+         */
+        const RoaringBitmap& postings(int player, PieceType type, int square) const;
+
+        std::uint32_t positionCount() const { return positions_; }
+        std::size_t gameCount() const { return game_starts_.size(); }
+
+        /**
+         * @brief Maps a position id back to where it occurs
+         * @param game Receives the game number (0-indexed, in indexing order)
+         * @param ply Receives the number of moves played before the position
+         * @return False if the id is not in the index
+         */
+        bool locate(std::uint32_t position, std::size_t& game, std::uint32_t& ply) const;
+
+        /**
+         * @return Positions where the player has at least two rooks on one row
+         */
+        RoaringBitmap rooksSharingRow(int player) const;
+
+        /**
+         * @return Positions where the player has a pawn one step from promotion
+         *      (row 6 for WHITE_PLAYER, who moves up, and row 1 for BLACK_PLAYER)
+         */
+        RoaringBitmap pawnsNearPromotion(int player) const;
+
+        /**
+         * @brief Writes the index to a file
+         * @return False if the file could not be written
+         */
+        bool save(const std::string& path) const;
+
+        /**
+         * @brief Replaces the index with one read from a file
+         * @return False (and the index is left empty) if the file is missing, truncated or malformed,
+         *      including game starts out of order or past the last position and postings of
+         *      positions that do not exist
+         */
+        bool load(const std::string& path);
+
+        void clear();
+};
+
+/**
+ * @brief Brute-force check of an index built with addGames(): replays the same games and, for
+ *      every position, compares each posting list, rooksSharingRow(), pawnsNearPromotion() and
+ *      locate() against a scan of the board
+ * @param decoder The stream the index was built from, positioned at its first game
+ * @return True if every position matched and the index holds no other positions or games
+ */
+bool checkPositionIndex(const PositionIndex& index, GameDecoder& decoder);
+
+#endif
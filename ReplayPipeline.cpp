@@ -0,0 +1,179 @@
+// File: ReplayPipeline.cpp
+// Date: 10/18/26
+// Implementation of the parallel replay pipeline
+
+#include "ReplayPipeline.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+void ReplayTotals::merge(const ReplayTotals& other) {
+    games += other.games;
+    games_replayed += other.games_replayed;
+    games_skipped += other.games_skipped;
+    moves += other.moves;
+    promotions += other.promotions;
+    castles += other.castles;
+    for (int player = 0; player < PLAYERS; player++) {
+        for (int type = 0; type < TYPES; type++) {
+            pieces[player][type] += other.pieces[player][type];
+        }
+    }
+    bytes += other.bytes;
+}
+
+std::size_t nextGameStart(std::string_view text, std::size_t offset) {
+    // The first line at or after the offset that starts with '['
+    std::size_t start = offset;
+    while (true) {
+        start = text.find('[', start);
+        if (start == std::string_view::npos) {
+            return text.size();
+        }
+        if (start == 0 || text[start - 1] == '\n') {
+            break;
+        }
+        start++;
+    }
+
+    // Back up to the first tag line of its block
+    while (start > 0) {
+        std::size_t newline = (start >= 2) ? text.rfind('\n', start - 2) : std::string_view::npos;
+        std::size_t line = (newline == std::string_view::npos) ? 0 : newline + 1;
+        if (text[line] != '[') {
+            break;
+        }
+        start = line;
+    }
+    return start;
+}
+
+void replayChunk(std::string_view text, Board& board, ReplayTotals& totals) {
+    GameParser parser(text);
+    GameRecord game;
+    while (parser.next(game)) {
+        totals.games++;
+        int moves = replayGame(game, board, [&totals](const Board& position, const Move& move, const Undo& undo) {
+            totals.moves++;
+            int row = move.to / Board::BOARD_LENGTH;
+            int col = move.to % Board::BOARD_LENGTH;
+            if (undo.moved.type() == PieceType::Pawn) {
+                // Judge the pawn where it landed, even if the move already turned it into a rook
+                PackedPiece pawn = undo.moved;
+                pawn.setPosition(row, col);
+                if (pawn.canPromote()) {
+                    totals.promotions++;
+                }
+            } else {
+                const PackedPiece& rook = position.at(move.to);
+                if (rook.canCastle(position.pieceAt(row, col - 1)) || rook.canCastle(position.pieceAt(row, col + 1))) {
+                    totals.castles++;
+                }
+            }
+        });
+
+        if (moves < 0) {
+            totals.games_skipped++;
+            continue;
+        }
+        totals.games_replayed++;
+        for (int player = 0; player < ReplayTotals::PLAYERS; player++) {
+            totals.pieces[player][static_cast<int>(PieceType::Pawn)] += board.count(PieceType::Pawn, player);
+            totals.pieces[player][static_cast<int>(PieceType::Rook)] += board.count(PieceType::Rook, player);
+        }
+    }
+    totals.bytes += text.size();
+}
+
+// Hands the whole pages inside a finished piece of a read-only mapping back to the kernel
+static void releasePages(std::string_view text) {
+    std::uintptr_t page = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+    std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(text.data());
+    std::uintptr_t end = begin + text.size();
+    begin = (begin + page - 1) / page * page;
+    end = end / page * page;
+    if (end > begin) {
+        madvise(reinterpret_cast<void*>(begin), end - begin, MADV_DONTNEED);
+    }
+}
+
+namespace {
+    // One thread's state, on its own cache lines so the counters never share a line
+    struct alignas(64) ReplayWorker {
+        Board board;
+        ReplayTotals totals;
+    };
+}
+
+ReplayTotals replayParallel(std::string_view text, int threads, std::size_t chunk_bytes, bool release_pages) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    if (threads <= 0) {
+        threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    chunk_bytes = std::max<std::size_t>(chunk_bytes, 1);
+
+    // Chunk boundaries, every one at the start of a game
+    std::vector<std::size_t> bounds(1, 0);
+    for (std::size_t offset = chunk_bytes; offset < text.size(); offset += chunk_bytes) {
+        std::size_t boundary = nextGameStart(text, offset);
+        if (boundary >= text.size()) {
+            break;
+        }
+        if (boundary > bounds.back()) {
+            bounds.push_back(boundary);
+        }
+        offset = std::max(offset, boundary);
+    }
+    if (bounds.back() < text.size()) {
+        bounds.push_back(text.size());
+    }
+    std::size_t chunks = bounds.size() - 1;
+    threads = static_cast<int>(std::min<std::size_t>(static_cast<std::size_t>(threads), std::max<std::size_t>(chunks, 1)));
+
+    // Threads take chunks in file order as they free up
+    std::vector<ReplayWorker> workers(static_cast<std::size_t>(threads));
+    std::atomic<std::size_t> next_chunk(0);
+    auto work = [&](ReplayWorker& worker) {
+        std::size_t chunk;
+        while ((chunk = next_chunk.fetch_add(1, std::memory_order_relaxed)) < chunks) {
+            std::string_view piece = text.substr(bounds[chunk], bounds[chunk + 1] - bounds[chunk]);
+            replayChunk(piece, worker.board, worker.totals);
+            if (release_pages) {
+                releasePages(piece);
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; i++) {
+        pool.emplace_back(work, std::ref(workers[static_cast<std::size_t>(i)]));
+    }
+    work(workers[0]);
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+
+    ReplayTotals totals;
+    for (const ReplayWorker& worker : workers) {
+        totals.merge(worker.totals);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    totals.seconds = elapsed.count();
+    return totals;
+}
+
+bool replayFileParallel(const std::string& path, ReplayTotals& totals, int threads) {
+    GameReader reader;
+    if (!reader.open(path)) {
+        return false;
+    }
+    totals = replayParallel(reader.text(), threads, std::size_t(16) << 20, true);
+    return true;
+}
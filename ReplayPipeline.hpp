@@ -0,0 +1,79 @@
+// File: ReplayPipeline.hpp
+// Date: 10/18/26
+// Replays a game archive on several threads: the text is split into chunks at game
+// boundaries, each thread replays chunks onto its own Board, and the per-thread totals
+// are merged at the end
+
+#ifndef REPLAY_PIPELINE_HPP
+#define REPLAY_PIPELINE_HPP
+
+#include "GameReader.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Statistics gathered while replaying. Each thread keeps its own and they are merged at the end.
+ */
+struct ReplayTotals {
+    static const int PLAYERS = 2;
+    static const int TYPES = 3;     // Indexed by PieceType (None, Pawn, Rook)
+
+    std::uint64_t games = 0;            // Games read
+    std::uint64_t games_replayed = 0;   // Games replayed to the end
+    std::uint64_t games_skipped = 0;    // Games that could not be replayed
+    std::uint64_t moves = 0;            // Moves made
+    std::uint64_t promotions = 0;       // Pawn moves ending where PackedPiece::canPromote() holds
+    std::uint64_t castles = 0;          // Rook moves ending next to a piece it canCastle() with
+    std::uint64_t pieces[PLAYERS][TYPES] = {};  // Final-position piece counts, by player and type
+    std::uint64_t bytes = 0;            // Archive bytes replayed
+    double seconds = 0;                 // Wall time of the whole run
+
+    /**
+     * @brief Adds another set of totals into this one. The elapsed time is not summed.
+     */
+    void merge(const ReplayTotals& other);
+
+    double megabytesPerSecond() const { return seconds > 0 ? bytes / seconds / (1024.0 * 1024.0) : 0; }
+    double gamesPerSecond() const { return seconds > 0 ? games / seconds : 0; }
+};
+
+/**
+ * @brief Finds where the first game starting at or after an offset begins: the top of the
+ *      tag pair block holding the first line at or after the offset that starts with '['.
+ *      Returns the same boundary for every offset inside one game, so chunks cut at these
+ *      boundaries never split a game.
+ * @return The boundary offset, or text.size() if no game starts after the offset
+ */
+std::size_t nextGameStart(std::string_view text, std::size_t offset);
+
+/**
+ * @brief Replays the games in a piece of archive text on one thread
+ * @param text Archive text. It should start at a game boundary.
+ * @param board Scratch board for the replay
+ * @param totals Receives the statistics (added to whatever it holds)
+ */
+void replayChunk(std::string_view text, Board& board, ReplayTotals& totals);
+
+/**
+ * @brief Replays all the games in archive text on several threads
+ * @param text The archive text
+ * @param threads Number of threads. 0 uses std::thread::hardware_concurrency().
+ * @param chunk_bytes Target chunk size. Chunks are handed out in file order as threads
+ *      free up, so only about threads * chunk_bytes of the text is being read at any time.
+ * @param release_pages If true, the text is a read-only file mapping, and the pages of each
+ *      finished chunk are handed back to the kernel (see GameReader)
+ * @return The merged statistics
+ */
+ReplayTotals replayParallel(std::string_view text, int threads = 0,
+                            std::size_t chunk_bytes = std::size_t(16) << 20, bool release_pages = false);
+
+/**
+ * @brief Maps an archive file and replays it with replayParallel(), releasing pages as it goes
+ * @param totals Receives the statistics
+ * @return False if the file could not be mapped
+ */
+bool replayFileParallel(const std::string& path, ReplayTotals& totals, int threads = 0);
+
+#endif
@@ -0,0 +1,612 @@
+// File: RoaringBitmap.cpp
+// Date: 10/18/26
+// Implementation of the RoaringBitmap class
+
+#include "RoaringBitmap.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <random>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#ifdef __AVX2__
+// Bits set in each 64-bit lane, counted a nibble at a time with a shuffle lookup
+static __m256i countLanes(__m256i words) {
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i nibbles = _mm256_set1_epi8(0x0F);
+    __m256i low = _mm256_shuffle_epi8(table, _mm256_and_si256(words, nibbles));
+    __m256i high = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(words, 4), nibbles));
+    return _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256());
+}
+
+// Sums the four 64-bit lanes of a vector
+static std::uint32_t sumLanes(__m256i lanes) {
+    __m128i half = _mm_add_epi64(_mm256_castsi256_si128(lanes), _mm256_extracti128_si256(lanes, 1));
+    return static_cast<std::uint32_t>(_mm_cvtsi128_si64(half) + _mm_extract_epi64(half, 1));
+}
+#endif
+
+// Number of bits set in a bitmap chunk
+static std::uint32_t countWords(const std::uint64_t* words) {
+    std::size_t i = 0;
+    std::uint32_t count = 0;
+#ifdef __AVX2__
+    __m256i lanes = _mm256_setzero_si256();
+    for (; i < RoaringBitmap::BITMAP_WORDS; i += 4) {
+        lanes = _mm256_add_epi64(lanes, countLanes(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i))));
+    }
+    count = sumLanes(lanes);
+#endif
+    for (; i < RoaringBitmap::BITMAP_WORDS; i++) {
+        count += static_cast<std::uint32_t>(__builtin_popcountll(words[i]));
+    }
+    return count;
+}
+
+// out = a & b over a bitmap chunk; returns the number of bits set
+static std::uint32_t andWords(const std::uint64_t* a, const std::uint64_t* b, std::uint64_t* out) {
+    std::size_t i = 0;
+#ifdef __AVX2__
+    for (; i < RoaringBitmap::BITMAP_WORDS; i += 4) {
+        __m256i words = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+                                         _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), words);
+    }
+#endif
+    for (; i < RoaringBitmap::BITMAP_WORDS; i++) {
+        out[i] = a[i] & b[i];
+    }
+    return countWords(out);
+}
+
+// out = a | b over a bitmap chunk; returns the number of bits set
+static std::uint32_t orWords(const std::uint64_t* a, const std::uint64_t* b, std::uint64_t* out) {
+    std::size_t i = 0;
+#ifdef __AVX2__
+    for (; i < RoaringBitmap::BITMAP_WORDS; i += 4) {
+        __m256i words = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+                                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), words);
+    }
+#endif
+    for (; i < RoaringBitmap::BITMAP_WORDS; i++) {
+        out[i] = a[i] | b[i];
+    }
+    return countWords(out);
+}
+
+// Counts the bits of a & b without storing them
+static std::uint32_t andCountWords(const std::uint64_t* a, const std::uint64_t* b) {
+    std::size_t i = 0;
+    std::uint32_t count = 0;
+#ifdef __AVX2__
+    __m256i lanes = _mm256_setzero_si256();
+    for (; i < RoaringBitmap::BITMAP_WORDS; i += 4) {
+        __m256i words = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+                                         _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+        lanes = _mm256_add_epi64(lanes, countLanes(words));
+    }
+    count = sumLanes(lanes);
+#endif
+    for (; i < RoaringBitmap::BITMAP_WORDS; i++) {
+        count += static_cast<std::uint32_t>(__builtin_popcountll(a[i] & b[i]));
+    }
+    return count;
+}
+
+// twice |= seen & bits, then seen |= bits, over a bitmap chunk
+static void accumulateWords(const std::uint64_t* bits, std::uint64_t* seen, std::uint64_t* twice) {
+    std::size_t i = 0;
+#ifdef __AVX2__
+    for (; i < RoaringBitmap::BITMAP_WORDS; i += 4) {
+        __m256i words = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bits + i));
+        __m256i before = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(seen + i));
+        __m256i again = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(twice + i)),
+                                        _mm256_and_si256(before, words));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(twice + i), again);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(seen + i), _mm256_or_si256(before, words));
+    }
+#endif
+    for (; i < RoaringBitmap::BITMAP_WORDS; i++) {
+        twice[i] |= seen[i] & bits[i];
+        seen[i] |= bits[i];
+    }
+}
+
+void RoaringBitmap::Container::add(std::uint16_t low) {
+    if (isBitmap()) {
+        std::uint64_t mask = std::uint64_t(1) << (low & 63);
+        if (!(bits[low >> 6] & mask)) {
+            bits[low >> 6] |= mask;
+            cardinality++;
+        }
+        return;
+    }
+
+    if (array.empty() || array.back() < low) {
+        array.push_back(low);
+    } else {
+        std::vector<std::uint16_t>::iterator it = std::lower_bound(array.begin(), array.end(), low);
+        if (*it == low) {
+            return;
+        }
+        array.insert(it, low);
+    }
+    cardinality++;
+    if (cardinality > ARRAY_MAX) {
+        toBitmap();
+    }
+}
+
+bool RoaringBitmap::Container::contains(std::uint16_t low) const {
+    if (isBitmap()) {
+        return bits[low >> 6] & (std::uint64_t(1) << (low & 63));
+    }
+    return std::binary_search(array.begin(), array.end(), low);
+}
+
+void RoaringBitmap::Container::toBitmap() {
+    bits.assign(BITMAP_WORDS, 0);
+    for (std::uint16_t low : array) {
+        bits[low >> 6] |= std::uint64_t(1) << (low & 63);
+    }
+    std::vector<std::uint16_t>().swap(array);
+}
+
+void RoaringBitmap::Container::toArray() {
+    array.clear();
+    array.reserve(cardinality);
+    for (std::size_t word = 0; word < BITMAP_WORDS; word++) {
+        for (std::uint64_t w = bits[word]; w != 0; w &= w - 1) {
+            array.push_back(static_cast<std::uint16_t>(word * 64 + __builtin_ctzll(w)));
+        }
+    }
+    std::vector<std::uint64_t>().swap(bits);
+}
+
+void RoaringBitmap::appendContainer(Container&& container) {
+    if (container.cardinality == 0) {
+        return;
+    }
+    if (container.isBitmap() && container.cardinality <= ARRAY_MAX) {
+        container.toArray();
+    } else if (!container.isBitmap() && container.cardinality > ARRAY_MAX) {
+        container.toBitmap();
+    }
+    containers_.push_back(std::move(container));
+}
+
+void RoaringBitmap::add(std::uint32_t value) {
+    std::uint16_t key = static_cast<std::uint16_t>(value >> 16);
+    std::uint16_t low = static_cast<std::uint16_t>(value & 0xFFFF);
+
+    // Increasing values only ever touch the last container
+    if (containers_.empty() || containers_.back().key < key) {
+        containers_.emplace_back();
+        containers_.back().key = key;
+        containers_.back().add(low);
+        return;
+    }
+    if (containers_.back().key == key) {
+        containers_.back().add(low);
+        return;
+    }
+
+    std::vector<Container>::iterator it = std::lower_bound(containers_.begin(), containers_.end(), key,
+        [](const Container& container, std::uint16_t k) { return container.key < k; });
+    if (it->key != key) {
+        it = containers_.emplace(it);
+        it->key = key;
+    }
+    it->add(low);
+}
+
+bool RoaringBitmap::contains(std::uint32_t value) const {
+    std::uint16_t key = static_cast<std::uint16_t>(value >> 16);
+    std::vector<Container>::const_iterator it = std::lower_bound(containers_.begin(), containers_.end(), key,
+        [](const Container& container, std::uint16_t k) { return container.key < k; });
+    return it != containers_.end() && it->key == key && it->contains(static_cast<std::uint16_t>(value & 0xFFFF));
+}
+
+std::uint64_t RoaringBitmap::cardinality() const {
+    std::uint64_t count = 0;
+    for (const Container& container : containers_) {
+        count += container.cardinality;
+    }
+    return count;
+}
+
+std::size_t RoaringBitmap::bytes() const {
+    std::size_t total = containers_.capacity() * sizeof(Container);
+    for (const Container& container : containers_) {
+        total += container.array.capacity() * sizeof(std::uint16_t) + container.bits.capacity() * sizeof(std::uint64_t);
+    }
+    return total;
+}
+
+RoaringBitmap RoaringBitmap::intersect(const RoaringBitmap& a, const RoaringBitmap& b) {
+    RoaringBitmap result;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < a.containers_.size() && j < b.containers_.size()) {
+        const Container& x = a.containers_[i];
+        const Container& y = b.containers_[j];
+        if (x.key != y.key) {
+            (x.key < y.key) ? i++ : j++;
+            continue;
+        }
+
+        Container out;
+        out.key = x.key;
+        if (x.isBitmap() && y.isBitmap()) {
+            out.bits.resize(BITMAP_WORDS);
+            out.cardinality = andWords(x.bits.data(), y.bits.data(), out.bits.data());
+        } else if (x.isBitmap() || y.isBitmap()) {
+            // Keep the array values the bitmap has
+            const Container& array = x.isBitmap() ? y : x;
+            const Container& bitmap = x.isBitmap() ? x : y;
+            out.array.reserve(array.cardinality);
+            for (std::uint16_t low : array.array) {
+                if (bitmap.bits[low >> 6] & (std::uint64_t(1) << (low & 63))) {
+                    out.array.push_back(low);
+                }
+            }
+            out.cardinality = static_cast<std::uint32_t>(out.array.size());
+        } else {
+            out.array.resize(std::min(x.array.size(), y.array.size()));
+            std::vector<std::uint16_t>::iterator end = std::set_intersection(
+                x.array.begin(), x.array.end(), y.array.begin(), y.array.end(), out.array.begin());
+            out.array.erase(end, out.array.end());
+            out.cardinality = static_cast<std::uint32_t>(out.array.size());
+        }
+        result.appendContainer(std::move(out));
+        i++;
+        j++;
+    }
+    return result;
+}
+
+RoaringBitmap RoaringBitmap::unite(const RoaringBitmap& a, const RoaringBitmap& b) {
+    RoaringBitmap result;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < a.containers_.size() || j < b.containers_.size()) {
+        if (j == b.containers_.size() || (i < a.containers_.size() && a.containers_[i].key < b.containers_[j].key)) {
+            result.containers_.push_back(a.containers_[i++]);
+            continue;
+        }
+        if (i == a.containers_.size() || b.containers_[j].key < a.containers_[i].key) {
+            result.containers_.push_back(b.containers_[j++]);
+            continue;
+        }
+
+        const Container& x = a.containers_[i++];
+        const Container& y = b.containers_[j++];
+        Container out;
+        out.key = x.key;
+        if (x.isBitmap() && y.isBitmap()) {
+            out.bits.resize(BITMAP_WORDS);
+            out.cardinality = orWords(x.bits.data(), y.bits.data(), out.bits.data());
+        } else if (x.isBitmap() || y.isBitmap()) {
+            const Container& array = x.isBitmap() ? y : x;
+            out = x.isBitmap() ? x : y;
+            for (std::uint16_t low : array.array) {
+                out.add(low);
+            }
+        } else {
+            out.array.resize(x.array.size() + y.array.size());
+            std::vector<std::uint16_t>::iterator end = std::set_union(
+                x.array.begin(), x.array.end(), y.array.begin(), y.array.end(), out.array.begin());
+            out.array.erase(end, out.array.end());
+            out.cardinality = static_cast<std::uint32_t>(out.array.size());
+        }
+        result.appendContainer(std::move(out));
+    }
+    return result;
+}
+
+std::uint32_t RoaringBitmap::maximum() const {
+    if (containers_.empty()) {
+        return 0;
+    }
+    const Container& last = containers_.back();
+    std::uint32_t high = static_cast<std::uint32_t>(last.key) << 16;
+    if (!last.isBitmap()) {
+        return high | last.array.back();
+    }
+    std::size_t word = BITMAP_WORDS - 1;
+    while (last.bits[word] == 0) {
+        word--;
+    }
+    return high | static_cast<std::uint32_t>(word * 64 + 63 - __builtin_clzll(last.bits[word]));
+}
+
+std::uint64_t RoaringBitmap::intersectCount(const RoaringBitmap& a, const RoaringBitmap& b) {
+    std::uint64_t count = 0;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < a.containers_.size() && j < b.containers_.size()) {
+        const Container& x = a.containers_[i];
+        const Container& y = b.containers_[j];
+        if (x.key != y.key) {
+            (x.key < y.key) ? i++ : j++;
+            continue;
+        }
+        if (x.isBitmap() && y.isBitmap()) {
+            count += andCountWords(x.bits.data(), y.bits.data());
+        } else if (x.isBitmap() || y.isBitmap()) {
+            const Container& array = x.isBitmap() ? y : x;
+            const Container& bitmap = x.isBitmap() ? x : y;
+            for (std::uint16_t low : array.array) {
+                count += (bitmap.bits[low >> 6] >> (low & 63)) & 1;
+            }
+        } else {
+            std::size_t p = 0;
+            std::size_t q = 0;
+            while (p < x.array.size() && q < y.array.size()) {
+                if (x.array[p] < y.array[q]) {
+                    p++;
+                } else if (y.array[q] < x.array[p]) {
+                    q++;
+                } else {
+                    count++;
+                    p++;
+                    q++;
+                }
+            }
+        }
+        i++;
+        j++;
+    }
+    return count;
+}
+
+RoaringBitmap RoaringBitmap::atLeastTwo(const RoaringBitmap* const* sets, std::size_t count, std::size_t group_size) {
+    RoaringBitmap result;
+    if (group_size < 2) {
+        return result;
+    }
+
+    // next[i]: the first container of sets[i] not yet combined. seen holds the chunk's values
+    // in the current group so far and is cleared after each group; twice collects the answer.
+    std::vector<std::size_t> next(count, 0);
+    std::vector<std::uint64_t> seen(BITMAP_WORDS, 0);
+    std::vector<std::uint64_t> twice(BITMAP_WORDS);
+    while (true) {
+        std::uint32_t key = 0x10000;
+        for (std::size_t i = 0; i < count; i++) {
+            if (next[i] < sets[i]->containers_.size()) {
+                key = std::min<std::uint32_t>(key, sets[i]->containers_[next[i]].key);
+            }
+        }
+        if (key == 0x10000) {
+            break;
+        }
+
+        std::fill(twice.begin(), twice.end(), 0);
+        for (std::size_t first = 0; first < count; first += group_size) {
+            std::size_t last = std::min(count, first + group_size);
+            bool dense = false;
+            for (std::size_t i = first; i < last; i++) {
+                if (next[i] == sets[i]->containers_.size() || sets[i]->containers_[next[i]].key != key) {
+                    continue;
+                }
+                const Container& container = sets[i]->containers_[next[i]];
+                if (container.isBitmap()) {
+                    accumulateWords(container.bits.data(), seen.data(), twice.data());
+                    dense = true;
+                    continue;
+                }
+                for (std::uint16_t low : container.array) {
+                    std::uint64_t mask = std::uint64_t(1) << (low & 63);
+                    twice[low >> 6] |= seen[low >> 6] & mask;
+                    seen[low >> 6] |= mask;
+                }
+            }
+
+            // Clear seen for the next group: all of it after a bitmap, or just the array values
+            for (std::size_t i = first; i < last; i++) {
+                if (next[i] == sets[i]->containers_.size() || sets[i]->containers_[next[i]].key != key) {
+                    continue;
+                }
+                if (!dense) {
+                    for (std::uint16_t low : sets[i]->containers_[next[i]].array) {
+                        seen[low >> 6] = 0;
+                    }
+                }
+                next[i]++;
+            }
+            if (dense) {
+                std::fill(seen.begin(), seen.end(), 0);
+            }
+        }
+
+        Container out;
+        out.key = static_cast<std::uint16_t>(key);
+        out.cardinality = countWords(twice.data());
+        if (out.cardinality > ARRAY_MAX) {
+            out.bits = twice;
+        } else if (out.cardinality > 0) {
+            out.array.reserve(out.cardinality);
+            for (std::size_t word = 0; word < BITMAP_WORDS; word++) {
+                for (std::uint64_t w = twice[word]; w != 0; w &= w - 1) {
+                    out.array.push_back(static_cast<std::uint16_t>(word * 64 + __builtin_ctzll(w)));
+                }
+            }
+        }
+        result.appendContainer(std::move(out));
+    }
+    return result;
+}
+
+void RoaringBitmap::write(std::vector<char>& out) const {
+    std::uint32_t count = static_cast<std::uint32_t>(containers_.size());
+    out.insert(out.end(), reinterpret_cast<const char*>(&count), reinterpret_cast<const char*>(&count) + sizeof(count));
+    for (const Container& container : containers_) {
+        std::uint32_t header[2] = { container.key, container.cardinality };
+        out.insert(out.end(), reinterpret_cast<const char*>(header), reinterpret_cast<const char*>(header) + sizeof(header));
+        const char* data = container.isBitmap() ? reinterpret_cast<const char*>(container.bits.data())
+                                                : reinterpret_cast<const char*>(container.array.data());
+        std::size_t length = container.isBitmap() ? BITMAP_WORDS * sizeof(std::uint64_t)
+                                                  : container.array.size() * sizeof(std::uint16_t);
+        out.insert(out.end(), data, data + length);
+    }
+}
+
+bool RoaringBitmap::read(const char*& cursor, const char* end) {
+    containers_.clear();
+    std::uint32_t count;
+    if (end - cursor < static_cast<std::ptrdiff_t>(sizeof(count))) {
+        return false;
+    }
+    std::memcpy(&count, cursor, sizeof(count));
+    cursor += sizeof(count);
+
+    for (std::uint32_t c = 0; c < count; c++) {
+        std::uint32_t header[2];
+        if (end - cursor < static_cast<std::ptrdiff_t>(sizeof(header))) {
+            containers_.clear();
+            return false;
+        }
+        std::memcpy(header, cursor, sizeof(header));
+        cursor += sizeof(header);
+
+        // Keys must increase and cardinalities fit a chunk
+        if (header[0] > 0xFFFF || header[1] == 0 || header[1] > 65536 ||
+            (!containers_.empty() && containers_.back().key >= header[0])) {
+            containers_.clear();
+            return false;
+        }
+        Container container;
+        container.key = static_cast<std::uint16_t>(header[0]);
+        container.cardinality = header[1];
+        bool bitmap = container.cardinality > ARRAY_MAX;
+        std::size_t length = bitmap ? BITMAP_WORDS * sizeof(std::uint64_t) : container.cardinality * sizeof(std::uint16_t);
+        if (static_cast<std::size_t>(end - cursor) < length) {
+            containers_.clear();
+            return false;
+        }
+        if (bitmap) {
+            container.bits.resize(BITMAP_WORDS);
+            std::memcpy(container.bits.data(), cursor, length);
+        } else {
+            container.array.resize(container.cardinality);
+            std::memcpy(container.array.data(), cursor, length);
+        }
+        cursor += length;
+
+        // Arrays must be strictly increasing and bitmaps hold exactly cardinality bits,
+        // or contains() and the set operations would give wrong answers
+        bool valid = true;
+        if (bitmap) {
+            std::uint32_t bits = 0;
+            for (std::uint64_t word : container.bits) {
+                bits += static_cast<std::uint32_t>(__builtin_popcountll(word));
+            }
+            valid = bits == container.cardinality;
+        } else {
+            for (std::size_t i = 1; valid && i < container.array.size(); i++) {
+                valid = container.array[i - 1] < container.array[i];
+            }
+        }
+        if (!valid) {
+            containers_.clear();
+            return false;
+        }
+        containers_.push_back(std::move(container));
+    }
+    return true;
+}
+
+bool RoaringBitmap::operator==(const RoaringBitmap& other) const {
+    if (containers_.size() != other.containers_.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < containers_.size(); i++) {
+        const Container& x = containers_[i];
+        const Container& y = other.containers_[i];
+        if (x.key != y.key || x.cardinality != y.cardinality || x.array != y.array || x.bits != y.bits) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool checkRoaringBitmap(unsigned seed, int rounds) {
+    std::mt19937 random(seed);
+    for (int round = 0; round < rounds; round++) {
+        // Dense rounds fill chunks past ARRAY_MAX so they become bitmaps; sparse ones stay arrays
+        std::uint32_t range = (round % 2 == 0) ? 3 * 65536 : 1 << 24;
+        std::uint32_t adds = (round % 2 == 0) ? 20000 : 2000;
+        RoaringBitmap a;
+        RoaringBitmap b;
+        std::vector<std::uint32_t> expected_a;
+        std::vector<std::uint32_t> expected_b;
+        for (std::uint32_t i = 0; i < adds; i++) {
+            std::uint32_t value = random() % range;
+            a.add(value);
+            expected_a.push_back(value);
+            value = random() % range;
+            b.add(value);
+            expected_b.push_back(value);
+        }
+        std::sort(expected_a.begin(), expected_a.end());
+        expected_a.erase(std::unique(expected_a.begin(), expected_a.end()), expected_a.end());
+        std::sort(expected_b.begin(), expected_b.end());
+        expected_b.erase(std::unique(expected_b.begin(), expected_b.end()), expected_b.end());
+
+        std::vector<std::uint32_t> both;
+        std::vector<std::uint32_t> either;
+        std::set_intersection(expected_a.begin(), expected_a.end(), expected_b.begin(), expected_b.end(), std::back_inserter(both));
+        std::set_union(expected_a.begin(), expected_a.end(), expected_b.begin(), expected_b.end(), std::back_inserter(either));
+
+        std::vector<std::uint32_t> values;
+        a.forEach([&values](std::uint32_t value) { values.push_back(value); });
+        if (values != expected_a || a.cardinality() != expected_a.size() || a.maximum() != expected_a.back()) {
+            return false;
+        }
+        for (int probe = 0; probe < 1000; probe++) {
+            std::uint32_t value = random() % range;
+            if (a.contains(value) != std::binary_search(expected_a.begin(), expected_a.end(), value)) {
+                return false;
+            }
+        }
+
+        values.clear();
+        RoaringBitmap::intersect(a, b).forEach([&values](std::uint32_t value) { values.push_back(value); });
+        if (values != both || RoaringBitmap::intersectCount(a, b) != both.size()) {
+            return false;
+        }
+        values.clear();
+        RoaringBitmap::unite(a, b).forEach([&values](std::uint32_t value) { values.push_back(value); });
+        if (values != either) {
+            return false;
+        }
+
+        // Three sets in groups of two, {a, b} and {c}: only a value in both a and b counts
+        RoaringBitmap c = RoaringBitmap::unite(a, b);
+        const RoaringBitmap* sets[3] = { &a, &b, &c };
+        values.clear();
+        RoaringBitmap::atLeastTwo(sets, 3, 2).forEach([&values](std::uint32_t value) { values.push_back(value); });
+        if (values != both) {
+            return false;
+        }
+        values.clear();
+        RoaringBitmap::atLeastTwo(sets, 3, 3).forEach([&values](std::uint32_t value) { values.push_back(value); });
+        if (values != either) {
+            return false;
+        }
+
+        std::vector<char> bytes;
+        a.write(bytes);
+        const char* cursor = bytes.data();
+        RoaringBitmap read;
+        if (!read.read(cursor, bytes.data() + bytes.size()) || cursor != bytes.data() + bytes.size() || read != a) {
+            return false;
+        }
+    }
+    return true;
+}
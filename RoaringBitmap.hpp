@@ -0,0 +1,142 @@
+// File: RoaringBitmap.hpp
+// Date: 10/18/26
+// A compressed bitmap of 32-bit values in the style of Roaring bitmaps, used for the
+// posting lists of PositionIndex
+
+#ifndef ROARING_BITMAP_HPP
+#define ROARING_BITMAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief A set of 32-bit values split into 65536-value chunks by their high 16 bits.
+ *      Each chunk is stored in whichever form is smaller: a sorted array of the low 16 bits
+ *      while it holds at most ARRAY_MAX values, or a 65536-bit bitmap (8 KB) beyond that.
+ *      Bitmap chunks are intersected, merged and counted a 256-bit AVX2 vector at a time
+ *      where AVX2 is enabled at compile time (-mavx2), and a word at a time otherwise.
+ */
+class RoaringBitmap {
+    public:
+        static const std::uint32_t ARRAY_MAX = 4096;    // Largest array chunk (8 KB, same as a bitmap)
+        static const std::size_t BITMAP_WORDS = 1024;   // 64-bit words in a bitmap chunk
+
+    private:
+        struct Container {
+            std::uint16_t key = 0;              // High 16 bits of every value in the chunk
+            std::uint32_t cardinality = 0;      // Number of values in the chunk
+            std::vector<std::uint16_t> array;   // Sorted low bits, while cardinality <= ARRAY_MAX
+            std::vector<std::uint64_t> bits;    // BITMAP_WORDS words once the chunk outgrows the array
+
+            bool isBitmap() const { return !bits.empty(); }
+            void add(std::uint16_t low);
+            bool contains(std::uint16_t low) const;
+            void toBitmap();
+            void toArray();
+        };
+
+        std::vector<Container> containers_;     // Sorted by key, none empty
+
+        // Adds a non-empty container to the end of the result of an operation
+        void appendContainer(Container&& container);
+
+    public:
+        /**
+         * @brief Adds a value. Values added in increasing order (as an indexer produces them)
+         *      are appended in amortized constant time.
+         */
+        void add(std::uint32_t value);
+
+        bool contains(std::uint32_t value) const;
+
+        /**
+         * @return The number of values in the set
+         */
+        std::uint64_t cardinality() const;
+
+        bool empty() const { return containers_.empty(); }
+        void clear() { containers_.clear(); }
+
+        /**
+         * @return The largest value in the set, or 0 if it is empty
+         */
+        std::uint32_t maximum() const;
+
+        /**
+         * @return The bytes of memory the chunks use, for sizing indexes
+         */
+        std::size_t bytes() const;
+
+        /**
+         * @return The values in both sets
+         */
+        static RoaringBitmap intersect(const RoaringBitmap& a, const RoaringBitmap& b);
+
+        /**
+         * @return The values in either set
+         */
+        static RoaringBitmap unite(const RoaringBitmap& a, const RoaringBitmap& b);
+
+        /**
+         * @return The number of values in both sets, without building the intersection
+         */
+        static std::uint64_t intersectCount(const RoaringBitmap& a, const RoaringBitmap& b);
+
+        /**
+         * @brief Finds the values in at least two sets of a group, for many groups in one pass:
+         *      the sets are taken group_size at a time (the last group may be shorter), and each
+         *      chunk is combined across every set in a scratch bitmap, so no intermediate sets
+         *      are built
+         * @return The values that at least two sets of some group have
+         */
+        static RoaringBitmap atLeastTwo(const RoaringBitmap* const* sets, std::size_t count, std::size_t group_size);
+
+        /**
+         * @brief Calls f(value) for each value in increasing order
+         */
+        template <typename F>
+        void forEach(F f) const {
+            for (const Container& container : containers_) {
+                std::uint32_t high = static_cast<std::uint32_t>(container.key) << 16;
+                if (!container.isBitmap()) {
+                    for (std::uint16_t low : container.array) {
+                        f(high | low);
+                    }
+                    continue;
+                }
+                for (std::size_t word = 0; word < BITMAP_WORDS; word++) {
+                    for (std::uint64_t bits = container.bits[word]; bits != 0; bits &= bits - 1) {
+                        f(high | static_cast<std::uint32_t>(word * 64 + __builtin_ctzll(bits)));
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Appends the set to a buffer: a container count, then each container's key,
+         *      cardinality and either its array or its bitmap words (native byte order)
+         */
+        void write(std::vector<char>& out) const;
+
+        /**
+         * @brief Reads a set written by write(), advancing cursor past it
+         * @return False if the data is truncated or malformed (the set is then left empty):
+         *      keys out of order, an array chunk not strictly increasing, or a bitmap chunk
+         *      whose bits do not add up to its cardinality
+         */
+        bool read(const char*& cursor, const char* end);
+
+        bool operator==(const RoaringBitmap& other) const;
+        bool operator!=(const RoaringBitmap& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Brute-force check: builds random sparse (array) and dense (bitmap) sets and compares
+ *      forEach, contains, cardinality, maximum, intersect, unite, intersectCount, atLeastTwo
+ *      and a write/read round trip against sorted std::vectors
+ * @return True if every round matched
+ */
+bool checkRoaringBitmap(unsigned seed = 1, int rounds = 20);
+
+#endif
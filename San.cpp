@@ -0,0 +1,147 @@
+// File: San.cpp
+// Date: 10/18/26
+// Implementation of the algebraic move resolver
+
+#include "San.hpp"
+#include <cstdint>
+
+// Parses a square name such as "e2" into a square index, or -1
+static int parseSquare(char file, char rank) {
+    if (file < 'a' || file >= 'a' + Board::BOARD_LENGTH || rank < '1' || rank >= '1' + Board::BOARD_LENGTH) {
+        return -1;
+    }
+    return (rank - '1') * Board::BOARD_LENGTH + (file - 'a');
+}
+
+// Finds the pawn that can reach `to`: one row back (diagonally for a capture), or two rows back
+// for a double jump onto an empty file
+static bool resolvePawn(const Board& board, int to, bool capture, int from_file, int from_rank,
+                        std::uint8_t flags, Move& move) {
+    int player = board.sideToMove();
+    int direction = (player == Board::WHITE_PLAYER) ? 1 : -1;
+    int to_col = to % Board::BOARD_LENGTH;
+    int from_row = to / Board::BOARD_LENGTH - direction;
+    if (from_row < 0 || from_row >= Board::BOARD_LENGTH) {
+        return false;
+    }
+
+    int from;
+    if (capture) {
+        // A pawn capture names its origin file ("exd5"), which must lie beside the target's
+        if (from_file < 0 || from_file >= Board::BOARD_LENGTH ||
+            (from_file != to_col - 1 && from_file != to_col + 1)) {
+            return false;
+        }
+        from = from_row * Board::BOARD_LENGTH + from_file;
+    } else {
+        if (from_file != -1 && from_file != to_col) {
+            return false;
+        }
+        from = from_row * Board::BOARD_LENGTH + to_col;
+        if (board.isEmpty(from)) {
+            from -= direction * Board::BOARD_LENGTH;
+            if (from < 0 || from >= Board::SQUARES) {
+                return false;
+            }
+        }
+    }
+    if (from < 0 || from >= Board::SQUARES) {
+        return false;
+    }
+    if (from_rank != -1 && from / Board::BOARD_LENGTH != from_rank) {
+        return false;
+    }
+
+    const PackedPiece& pawn = board.at(from);
+    if (pawn.type() != PieceType::Pawn || pawn.getColor() != player) {
+        return false;
+    }
+    move = Move(from, to, flags);
+    return board.isPseudoLegal(move);
+}
+
+// Walks the four lines out of `to` looking for the one rook of the side to move that can reach it
+static bool resolveRook(const Board& board, int to, int from_file, int from_rank, Move& move) {
+    static const int STEPS[4][2] = { {1, 0}, {-1, 0}, {0, 1}, {0, -1} };
+
+    int player = board.sideToMove();
+    int found = -1;
+    for (const int* step : STEPS) {
+        int row = to / Board::BOARD_LENGTH + step[0];
+        int col = to % Board::BOARD_LENGTH + step[1];
+        while (row >= 0 && row < Board::BOARD_LENGTH && col >= 0 && col < Board::BOARD_LENGTH) {
+            int square = row * Board::BOARD_LENGTH + col;
+            if (!board.isEmpty(square)) {
+                const PackedPiece& piece = board.at(square);
+                if (piece.type() == PieceType::Rook && piece.getColor() == player &&
+                    (from_file == -1 || from_file == col) && (from_rank == -1 || from_rank == row)) {
+                    if (found != -1) {
+                        return false;   // Ambiguous
+                    }
+                    found = square;
+                }
+                break;
+            }
+            row += step[0];
+            col += step[1];
+        }
+    }
+    if (found == -1) {
+        return false;
+    }
+    move = Move(found, to);
+    return board.isPseudoLegal(move);
+}
+
+bool parseSan(std::string_view san, const Board& board, Move& move) {
+    // Check, mate and annotation suffixes
+    while (!san.empty() && (san.back() == '+' || san.back() == '#' || san.back() == '!' || san.back() == '?')) {
+        san.remove_suffix(1);
+    }
+
+    // Promotion, which can only be to a rook
+    std::uint8_t flags = 0;
+    std::size_t equals = san.find('=');
+    if (equals != std::string_view::npos) {
+        if (equals + 2 != san.size() || san[equals + 1] != 'R') {
+            return false;
+        }
+        flags = Move::PROMOTION;
+        san = san.substr(0, equals);
+    }
+
+    bool rook = !san.empty() && san[0] == 'R';
+    if (rook) {
+        san.remove_prefix(1);
+    }
+
+    // Destination square, capture mark, then an optional origin file and/or rank
+    if (san.size() < 2) {
+        return false;
+    }
+    int to = parseSquare(san[san.size() - 2], san[san.size() - 1]);
+    if (to == -1) {
+        return false;
+    }
+    san.remove_suffix(2);
+    bool capture = !san.empty() && san.back() == 'x';
+    if (capture) {
+        san.remove_suffix(1);
+    }
+    int from_file = -1;
+    int from_rank = -1;
+    for (char c : san) {
+        if (c >= 'a' && c < 'a' + Board::BOARD_LENGTH && from_file == -1 && from_rank == -1) {
+            from_file = c - 'a';
+        } else if (c >= '1' && c < '1' + Board::BOARD_LENGTH && from_rank == -1) {
+            from_rank = c - '1';
+        } else {
+            return false;   // Other piece letters, castling, anything unexpected
+        }
+    }
+
+    if (rook) {
+        return flags == 0 && resolveRook(board, to, from_file, from_rank, move);
+    }
+    return resolvePawn(board, to, capture, from_file, from_rank, flags, move);
+}
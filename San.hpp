@@ -0,0 +1,24 @@
+// File: San.hpp
+// Date: 10/18/26
+// Resolves algebraic move text ("e4", "exd5", "e8=R", "Rad1") against a Board
+
+#ifndef SAN_HPP
+#define SAN_HPP
+
+#include "Board.hpp"
+#include <string_view>
+
+/**
+ * @brief Resolves a move in standard algebraic notation for the side to move.
+ *      Pawn moves ("e4", "exd5", "e8=R") and rook moves ("Rd1", "Rxd1", "Rad1", "R1d4") are
+ *      understood. Check, mate and annotation suffixes ("+", "#", "!", "?") are ignored.
+ *      Other pieces, castling and promotion to anything but a rook have no Board
+ *      representation, so they are rejected. Does not allocate.
+ * @param san The move text
+ * @param board The position the move is played from
+ * @param move Receives the move
+ * @return True if the text names exactly one pseudo-legal move. False otherwise.
+ */
+bool parseSan(std::string_view san, const Board& board, Move& move);
+
+#endif
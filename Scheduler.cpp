@@ -0,0 +1,230 @@
+// File: Scheduler.cpp
+// Date: 10/18/26
+// Implementation of the Scheduler and TaskGroup classes
+
+#include "Scheduler.hpp"
+#include <algorithm>
+#include <chrono>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Failed searches for work before a worker goes to sleep
+static const int SPIN_ROUNDS = 64;
+
+thread_local Scheduler* Scheduler::current_scheduler_ = nullptr;
+thread_local int Scheduler::current_worker_ = -1;
+
+// Pins the calling thread to one CPU
+static void pinThread(int index) {
+#ifdef __linux__
+    int cpus = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(index % cpus, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)index;
+#endif
+}
+
+Scheduler::Scheduler(int threads, bool pin_threads) :
+    injected_count_(0),
+    epoch_(0),
+    sleepers_(0),
+    stop_(false) {
+    if (threads <= 0) {
+        threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    for (int i = 0; i < threads; i++) {
+        workers_.push_back(std::unique_ptr<Worker>(new Worker()));
+    }
+    for (int i = 0; i < threads; i++) {
+        threads_.emplace_back(&Scheduler::run, this, i, pin_threads);
+    }
+}
+
+Scheduler::~Scheduler() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_.store(true);
+        epoch_.fetch_add(1);
+    }
+    wake_.notify_all();
+    for (std::thread& thread : threads_) {
+        thread.join();
+    }
+}
+
+void Scheduler::execute(Task* task) {
+    task->execute();
+    TaskGroup* group = task->group;
+    delete task;
+    // Last: once pending_ drops the group's owner may return and destroy it
+    if (group != nullptr) {
+        group->pending_.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+bool Scheduler::hasWork() const {
+    if (injected_count_.load(std::memory_order_relaxed) > 0) {
+        return true;
+    }
+    for (const std::unique_ptr<Worker>& worker : workers_) {
+        if (worker->deque.size() > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Task* Scheduler::findTask(int index) {
+    Task* task;
+    if (index >= 0 && workers_[static_cast<std::size_t>(index)]->deque.pop(task)) {
+        return task;
+    }
+
+    if (injected_count_.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(inject_mutex_);
+        if (!injected_.empty()) {
+            task = injected_.front();
+            injected_.pop_front();
+            injected_count_.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    // Steal, starting with the next worker round so thieves spread out
+    std::size_t count = workers_.size();
+    std::size_t start = (index >= 0) ? static_cast<std::size_t>(index) + 1 : 0;
+    for (std::size_t k = 0; k < count; k++) {
+        std::size_t victim = (start + k) % count;
+        if (static_cast<int>(victim) != index && workers_[victim]->deque.steal(task)) {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void Scheduler::schedule(Task* task) {
+    if (current_scheduler_ == this) {
+        workers_[static_cast<std::size_t>(current_worker_)]->deque.push(task);
+    } else {
+        std::lock_guard<std::mutex> lock(inject_mutex_);
+        injected_.push_back(task);
+        injected_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Pairs with the fence in run(): either a sleeper sees the task, or we see the sleeper
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_relaxed) > 0) {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            epoch_.fetch_add(1);
+        }
+        wake_.notify_one();
+    }
+}
+
+void Scheduler::run(int index, bool pin) {
+    current_scheduler_ = this;
+    current_worker_ = index;
+    if (pin) {
+        pinThread(index);
+    }
+
+    int idle = 0;
+    while (true) {
+        Task* task = findTask(index);
+        if (task != nullptr) {
+            execute(task);
+            idle = 0;
+            continue;
+        }
+        if (stop_.load() && !hasWork()) {
+            return;
+        }
+        if (++idle < SPIN_ROUNDS) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Announce the nap, then look once more so a task scheduled meanwhile is not missed
+        std::uint64_t epoch = epoch_.load();
+        sleepers_.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!hasWork() && !stop_.load()) {
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            wake_.wait(lock, [this, epoch] { return epoch_.load() != epoch || stop_.load(); });
+        }
+        sleepers_.fetch_sub(1);
+        idle = 0;
+    }
+}
+
+bool Scheduler::runOne() {
+    Task* task = findTask(current_scheduler_ == this ? current_worker_ : -1);
+    if (task == nullptr) {
+        return false;
+    }
+    execute(task);
+    return true;
+}
+
+void TaskGroup::wait() {
+    while (pending_.load(std::memory_order_acquire) > 0) {
+        if (!scheduler_.runOne()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+SchedulerBenchmark benchmarkScheduler(Scheduler& scheduler, int tasks, std::size_t items) {
+    typedef std::chrono::steady_clock Clock;
+    SchedulerBenchmark result;
+    result.threads = scheduler.size();
+    tasks = std::max(tasks, 1);
+    std::atomic<int> counter(0);
+
+    // Spawn overhead: every task spawned from this thread, then joined
+    Clock::time_point start = Clock::now();
+    {
+        TaskGroup group(scheduler);
+        for (int i = 0; i < tasks; i++) {
+            group.run([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+        }
+        group.wait();
+    }
+    result.spawn_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / tasks;
+
+    // The naive alternative: a std::thread per task, started in batches of one per worker
+    int thread_tasks = std::max(1, tasks / 10);
+    start = Clock::now();
+    for (int done = 0; done < thread_tasks; ) {
+        std::vector<std::thread> batch;
+        for (int i = 0; i < result.threads && done < thread_tasks; i++, done++) {
+            batch.emplace_back([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+        }
+        for (std::thread& thread : batch) {
+            thread.join();
+        }
+    }
+    result.thread_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / thread_tasks;
+
+    // Scalability: a cheap hash per item, serially and with parallelFor
+    std::vector<std::uint32_t> data(std::max<std::size_t>(items, 1));
+    auto body = [&data](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            std::uint32_t x = static_cast<std::uint32_t>(i) * 2654435761u;
+            data[i] = x ^ (x >> 15);
+        }
+    };
+    start = Clock::now();
+    body(0, data.size());
+    result.serial_for_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / data.size();
+    start = Clock::now();
+    scheduler.parallelFor(0, data.size(), 4096, body);
+    result.parallel_for_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / data.size();
+    return result;
+}
@@ -0,0 +1,217 @@
+// File: Scheduler.hpp
+// Date: 10/18/26
+// A work-stealing task scheduler: one Chase-Lev deque per worker thread, fork/join
+// task groups and a parallel-for over index ranges
+
+#ifndef SCHEDULER_HPP
+#define SCHEDULER_HPP
+
+#include "ChaseLevDeque.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class TaskGroup;
+
+/**
+ * @brief A unit of work. The scheduler deletes it after running it.
+ */
+struct Task {
+    TaskGroup* group = nullptr;     // Group told when the task finishes, if any
+
+    virtual ~Task() = default;
+    virtual void execute() = 0;
+};
+
+// A Task running a callable
+template <typename F>
+struct FunctionTask : Task {
+    F function;
+
+    explicit FunctionTask(F&& f) : function(std::move(f)) {}
+    void execute() override { function(); }
+};
+
+/**
+ * @brief Runs tasks on a fixed set of worker threads. Each worker pushes the tasks it spawns onto
+ *      its own deque and takes the newest first (good for fork/join locality); a worker that runs
+ *      dry steals the oldest task of another worker. Tasks spawned from outside the pool go into
+ *      a shared injection queue. Idle workers spin briefly, then sleep until work arrives.
+ */
+class Scheduler {
+    private:
+        struct alignas(64) Worker {
+            ChaseLevDeque<Task*> deque;     // Tasks spawned by this worker
+        };
+
+        std::vector<std::unique_ptr<Worker>> workers_;  // One per thread
+        std::vector<std::thread> threads_;              // The worker threads
+        std::mutex inject_mutex_;                       // Guards injected_
+        std::deque<Task*> injected_;                    // Tasks spawned outside the pool
+        std::atomic<std::int64_t> injected_count_;      // injected_.size(), readable without the lock
+        std::mutex sleep_mutex_;                        // Guards epoch_ changes and stop_
+        std::condition_variable wake_;                  // Wakes sleeping workers
+        std::atomic<std::uint64_t> epoch_;              // Bumped whenever sleepers must re-check for work
+        std::atomic<int> sleepers_;                     // Workers asleep or about to sleep
+        std::atomic<bool> stop_;                        // Set by the destructor
+
+        static thread_local Scheduler* current_scheduler_;  // Scheduler of this thread, if a worker
+        static thread_local int current_worker_;            // Worker index, -1 outside any pool
+
+        // Worker thread body
+        void run(int index, bool pin);
+
+        // Takes a task for the calling thread: own deque, then injected, then stolen
+        Task* findTask(int index);
+
+        // True if any deque or the injection queue looks non-empty
+        bool hasWork() const;
+
+        // Queues a task: on the caller's deque if it is one of our workers, injected otherwise
+        void schedule(Task* task);
+
+        // Runs a task and tells its group
+        static void execute(Task* task);
+
+        template <typename F>
+        void forkRange(TaskGroup& group, std::size_t begin, std::size_t end, std::size_t grain, const F& body);
+
+        friend class TaskGroup;
+
+    public:
+        /**
+         * @brief Parameterized constructor: starts the worker threads
+         * @param threads Worker threads. 0 uses std::thread::hardware_concurrency().
+         * @param pin_threads If true, worker i is pinned to CPU i (modulo the CPU count).
+         *      Only supported on Linux; elsewhere it is ignored.
+         */
+        explicit Scheduler(int threads = 0, bool pin_threads = false);
+
+        /**
+         * @brief Destructor: runs every queued task (and whatever they spawn), then joins the workers
+         */
+        ~Scheduler();
+
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator=(const Scheduler&) = delete;
+
+        /**
+         * @brief Runs a callable on the pool, detached from any group
+         */
+        template <typename F>
+        void spawn(F&& function) {
+            schedule(new FunctionTask<typename std::decay<F>::type>(std::forward<F>(function)));
+        }
+
+        /**
+         * @brief Calls body(chunk_begin, chunk_end) over [begin, end) split into chunks of at most
+         *      `grain` indexes, in parallel, and returns when all chunks are done. The range is split
+         *      in halves recursively, so idle workers steal large pieces first.
+         *      Use it over an index range of a batch, eg. a vector of boxes or positions.
+         */
+        template <typename F>
+        void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, const F& body);
+
+        /**
+         * @brief Runs one queued task on the calling thread, if there is one
+         * @return False if no task could be found
+         */
+        bool runOne();
+
+        int size() const { return static_cast<int>(workers_.size()); }
+
+        /**
+         * @return The calling thread's worker index in its scheduler, or -1 outside a worker
+         */
+        static int currentWorker() { return current_worker_; }
+};
+
+/**
+ * @brief Fork/join: run() spawns tasks and wait() returns once all of them (and nothing else) have
+ *      finished. The waiting thread runs queued tasks while it waits instead of blocking, so groups
+ *      can be nested inside tasks without deadlocking the pool.
+ */
+class TaskGroup {
+    private:
+        Scheduler& scheduler_;              // Runs the tasks
+        std::atomic<std::int64_t> pending_; // Tasks spawned and not yet finished
+
+        friend class Scheduler;
+
+    public:
+        explicit TaskGroup(Scheduler& scheduler) : scheduler_(scheduler), pending_(0) {}
+
+        /**
+         * @brief Destructor: waits for the group's tasks
+         */
+        ~TaskGroup() { wait(); }
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        /**
+         * @brief Spawns a callable as part of the group
+         */
+        template <typename F>
+        void run(F&& function) {
+            Task* task = new FunctionTask<typename std::decay<F>::type>(std::forward<F>(function));
+            task->group = this;
+            pending_.fetch_add(1, std::memory_order_relaxed);
+            scheduler_.schedule(task);
+        }
+
+        /**
+         * @brief Runs queued tasks until every task of the group has finished
+         */
+        void wait();
+};
+
+template <typename F>
+void Scheduler::forkRange(TaskGroup& group, std::size_t begin, std::size_t end, std::size_t grain, const F& body) {
+    // Hand the upper half to a thief and keep splitting the lower half
+    while (end - begin > grain) {
+        std::size_t middle = begin + (end - begin) / 2;
+        group.run([this, &group, middle, end, grain, &body] { forkRange(group, middle, end, grain, body); });
+        end = middle;
+    }
+    body(begin, end);
+}
+
+template <typename F>
+void Scheduler::parallelFor(std::size_t begin, std::size_t end, std::size_t grain, const F& body) {
+    if (begin >= end) {
+        return;
+    }
+    TaskGroup group(*this);
+    forkRange(group, begin, end, grain == 0 ? 1 : grain, body);
+    group.wait();
+}
+
+/**
+ * @brief Results of benchmarkScheduler(): task spawn overhead against a std::thread per task,
+ *      and parallel-for throughput on 1 worker versus all of them
+ */
+struct SchedulerBenchmark {
+    int threads = 0;                    // Workers in the scheduler
+    double spawn_ns = 0;                // Spawn + run + join of an empty task, per task
+    double thread_ns = 0;               // Create + join of a std::thread running an empty task, per task
+    double parallel_for_ns = 0;         // parallelFor over `items` tiny bodies, per item, all workers
+    double serial_for_ns = 0;           // The same loop on one thread, per item
+    double speedup() const { return parallel_for_ns > 0 ? serial_for_ns / parallel_for_ns : 0; }
+};
+
+/**
+ * @brief Micro-benchmarks the scheduler
+ * @param tasks Empty tasks to spawn (std::threads use tasks / 10, at least 1)
+ * @param items Range length for the parallel-for comparison
+ */
+SchedulerBenchmark benchmarkScheduler(Scheduler& scheduler, int tasks = 100000, std::size_t items = 1 << 22);
+
+#endif
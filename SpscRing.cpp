@@ -0,0 +1,58 @@
+// File: SpscRing.cpp
+// Date: 10/18/26
+// Implementation of the SpscRing template class
+
+#ifndef SPSC_RING_CPP_
+#define SPSC_RING_CPP_
+
+#include "SpscRing.hpp"
+
+template <typename T>
+SpscRing<T>::SpscRing(std::size_t capacity) : head_(0), cached_tail_(0), tail_(0), cached_head_(0) {
+    capacity_ = 2;
+    while (capacity_ < capacity) {
+        capacity_ *= 2;
+    }
+    mask_ = capacity_ - 1;
+    slots_ = new T[capacity_];
+}
+
+template <typename T>
+SpscRing<T>::~SpscRing() {
+    delete[] slots_;
+}
+
+template <typename T>
+bool SpscRing<T>::tryPush(const T& value) {
+    // Indexes grow without wrapping; head - tail is the number of items
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head - cached_tail_ == capacity_) {
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        if (head - cached_tail_ == capacity_) {
+            return false;
+        }
+    }
+    slots_[head & mask_] = value;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+std::size_t SpscRing<T>::popBatch(T* out, std::size_t max) {
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (cached_head_ - tail < max) {
+        cached_head_ = head_.load(std::memory_order_acquire);
+    }
+    std::size_t count = cached_head_ - tail;
+    if (count > max) {
+        count = max;
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        out[i] = slots_[(tail + i) & mask_];
+    }
+    // One release store hands all the slots back to the producer at once
+    tail_.store(tail + count, std::memory_order_release);
+    return count;
+}
+
+#endif
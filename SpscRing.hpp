@@ -0,0 +1,63 @@
+// File: SpscRing.hpp
+// Date: 10/18/26
+// A bounded, lock-free single-producer single-consumer ring buffer
+
+#ifndef SPSC_RING_HPP_
+#define SPSC_RING_HPP_
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief A fixed-size ring of T for exactly one producer thread and one consumer thread.
+ *      Neither side ever blocks or allocates: a push into a full ring fails immediately.
+ *      Each side keeps a cached copy of the other side's index, so the shared indexes are
+ *      only read again when the ring looks full (producer) or empty (consumer).
+ *      T must be trivially copyable in spirit: it is copied in and out by assignment.
+ */
+template <typename T>
+class SpscRing {
+    private:
+        T* slots_;                                  // capacity_ slots
+        std::size_t capacity_;                      // A power of 2
+        std::size_t mask_;                          // capacity_ - 1
+
+        alignas(64) std::atomic<std::size_t> head_;     // Next slot to write (producer)
+        std::size_t cached_tail_;                       // Producer's copy of tail_
+        alignas(64) std::atomic<std::size_t> tail_;     // Next slot to read (consumer)
+        std::size_t cached_head_;                       // Consumer's copy of head_
+
+    public:
+        /**
+         * @param capacity Number of slots, rounded up to a power of 2 (at least 2)
+         */
+        explicit SpscRing(std::size_t capacity);
+        ~SpscRing();
+
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+
+        std::size_t capacity() const { return capacity_; }
+
+        /**
+         * @brief Appends an item. Producer thread only.
+         * @return False (and nothing is written) if the ring is full
+         */
+        bool tryPush(const T& value);
+
+        /**
+         * @brief Removes up to `max` of the oldest items into out. Consumer thread only.
+         * @return The number of items removed
+         */
+        std::size_t popBatch(T* out, std::size_t max);
+
+        /**
+         * @return The number of items waiting. Exact on either side's thread when the other is idle.
+         */
+        std::size_t size() const {
+            return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+        }
+};
+
+#include "SpscRing.cpp"
+#endif // SPSC_RING_HPP_
@@ -0,0 +1,437 @@
+// File: bench.cpp
+// Date: 10/18/26
+// Benchmarks for the library: runs every benchmark the library provides and prints
+// its results. Built and run by `make bench`.
+
+#include "Board.hpp"
+#include "Box.hpp"
+#include "ChessBox.hpp"
+#include "ChessBoxSnapshot.hpp"
+#include "ChessPiece.hpp"
+#include "ConcurrentLinkedBox.hpp"
+#include "GameServer.hpp"
+#include "Fen.hpp"
+#include "GameReader.hpp"
+#include "MappedArrayBox.hpp"
+#include "NeuralEvaluation.hpp"
+#include "PackedPiece.hpp"
+#include "PieceTable.hpp"
+#include "PositionIndex.hpp"
+#include "RoaringBitmap.hpp"
+#include "Scheduler.hpp"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Box storage policies on each operation mix, for working sets of 8 and 64 pieces
+static void benchBoxPolicies() {
+    std::cout << "Box policies, ns/op:       array   linked unrolled   inline" << std::endl;
+    std::vector<ChessPiece> pieces;
+    for (int i = 0; i < 64; i++) {
+        bool rook = i % 4 == 0;
+        pieces.push_back(ChessPiece("WHITE", i / 8, i % 8, true, rook ? 2 : 1, rook ? "ROOK" : "PAWN"));
+    }
+    for (int count : { 8, 64 }) {
+        std::vector<ChessPiece> working(pieces.begin(), pieces.begin() + count);
+        for (const BoxBenchmark& row : benchmarkBoxPolicies(working, 20000)) {
+            std::printf("  %2d pieces %-13s %8.1f %8.1f %8.1f %8.1f%s\n", count, boxMixName(row.mix),
+                        row.array_ns, row.linked_ns, row.unrolled_ns, row.inline_ns,
+                        row.items < 0 ? "  (policies disagree)" : "");
+        }
+    }
+}
+
+// Filling a new Box<PackedPiece> with `count` items one addItem() at a time and with one
+// addItems(), and refilling a box after removing everything; ns per item
+template <template <typename> class Storage>
+static void timeBatchAdd(const std::vector<PackedPiece>& items, int rounds, double& loop_ns, double& batch_ns,
+                         double& refill_ns) {
+    typedef std::chrono::steady_clock Clock;
+    int count = static_cast<int>(items.size());
+    long long added = 0;
+    Clock::time_point start = Clock::now();
+    for (int round = 0; round < rounds; round++) {
+        Box<PackedPiece, Storage> box(2 * count);
+        for (const PackedPiece& item : items) {
+            added += box.addItem(item);
+        }
+    }
+    loop_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / (static_cast<double>(rounds) * count);
+
+    start = Clock::now();
+    for (int round = 0; round < rounds; round++) {
+        Box<PackedPiece, Storage> box(2 * count);
+        added += box.addItems(items.data(), count) ? count : 0;
+    }
+    batch_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / (static_cast<double>(rounds) * count);
+
+    // Removed nodes go back to the storage, so refilling reuses them
+    Box<PackedPiece, Storage> box(2 * count);
+    start = Clock::now();
+    for (int round = 0; round < rounds; round++) {
+        box.addItems(items.data(), count);
+        for (const PackedPiece& item : items) {
+            added += box.remove(item.getType());
+        }
+    }
+    refill_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / (static_cast<double>(rounds) * count);
+    if (added != 3LL * rounds * count) {
+        loop_ns = -1;
+    }
+}
+
+// Setting up 32 pieces: addPiece() per piece on a new ChessBox against replaceAll() on a reused
+// one; us per setup
+template <template <typename> class Storage>
+static void timeChessBoxSetup(const std::vector<ChessPiece>& pieces, int rounds, double& loop_us, double& replace_us) {
+    typedef std::chrono::steady_clock Clock;
+    long long added = 0;
+    Clock::time_point start = Clock::now();
+    for (int round = 0; round < rounds; round++) {
+        BasicChessBox<Storage> box;
+        for (const ChessPiece& piece : pieces) {
+            added += box.addPiece(piece);
+        }
+    }
+    loop_us = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / rounds;
+
+    BasicChessBox<Storage> box;
+    start = Clock::now();
+    for (int round = 0; round < rounds; round++) {
+        added += box.replaceAll(pieces) ? static_cast<long long>(pieces.size()) : 0;
+    }
+    replace_us = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / rounds;
+    if (added != 2LL * rounds * static_cast<long long>(pieces.size())) {
+        loop_us = -1;
+    }
+}
+
+// Box batch adds: per-item addItem() against one addItems(), for each storage policy, then
+// the same comparison for a whole ChessBox position
+static void benchBatchAdd() {
+    std::cout << "Box batch add, ns/item:   loop    batch  refill" << std::endl;
+    for (int count : { 32, 1024 }) {
+        std::vector<PackedPiece> items;
+        for (int i = 0; i < count; i++) {
+            items.push_back(PackedPiece(i % 4 == 0 ? PieceType::Rook : PieceType::Pawn, 1, (i / 8) % 8, i % 8, true));
+        }
+        int rounds = 2000000 / count;
+        double loop_ns, batch_ns, refill_ns;
+        timeBatchAdd<ArrayStorage>(items, rounds, loop_ns, batch_ns, refill_ns);
+        std::printf("  %4d array    %8.1f %8.1f %7.1f\n", count, loop_ns, batch_ns, refill_ns);
+        timeBatchAdd<LinkedStorage>(items, rounds, loop_ns, batch_ns, refill_ns);
+        std::printf("  %4d linked   %8.1f %8.1f %7.1f\n", count, loop_ns, batch_ns, refill_ns);
+        timeBatchAdd<UnrolledStorage>(items, rounds, loop_ns, batch_ns, refill_ns);
+        std::printf("  %4d unrolled %8.1f %8.1f %7.1f\n", count, loop_ns, batch_ns, refill_ns);
+    }
+
+    std::vector<ChessPiece> pieces;
+    for (int player = 0; player < 2; player++) {
+        const char* color = player == 0 ? "BLACK" : "WHITE";
+        for (int col = 0; col < 8; col++) {
+            pieces.push_back(ChessPiece(color, player == 0 ? 6 : 1, col, player == 1, 1, "PAWN"));
+            pieces.push_back(ChessPiece(color, player == 0 ? 7 : 0, col, player == 1, 2, "ROOK"));
+        }
+    }
+    const int rounds = 20000;
+    double loop_us, replace_us;
+    std::cout << "ChessBox 32-piece setup, us: loop  replaceAll" << std::endl;
+    timeChessBoxSetup<ArrayStorage>(pieces, rounds, loop_us, replace_us);
+    std::printf("  array    %18.2f %11.2f\n", loop_us, replace_us);
+    timeChessBoxSetup<LinkedStorage>(pieces, rounds, loop_us, replace_us);
+    std::printf("  linked   %18.2f %11.2f\n", loop_us, replace_us);
+    timeChessBoxSetup<UnrolledStorage>(pieces, rounds, loop_us, replace_us);
+    std::printf("  unrolled %18.2f %11.2f\n", loop_us, replace_us);
+    timeChessBoxSetup<InlineStorage>(pieces, rounds, loop_us, replace_us);
+    std::printf("  inline   %18.2f %11.2f\n", loop_us, replace_us);
+}
+
+// Reopening a mapped box file against rebuilding an ArrayBox, on 1M pieces
+static void benchMappedBox() {
+    std::vector<PackedPiece> items;
+    for (int i = 0; i < (1 << 20); i++) {
+        items.push_back(PackedPiece(i % 3 == 0 ? PieceType::Rook : PieceType::Pawn, i % 2, (i / 8) % 8, i % 8, true));
+    }
+    MappedBoxBenchmark result = benchmarkMappedBox("bench_box.bin", items);
+    std::remove("bench_box.bin");
+    std::printf("MappedArrayBox, %d items: open %.0f ns, rebuild %.0f ns, random at() %.1f ns mapped / %.1f ns rebuilt\n",
+                result.items, result.open_ns, result.rebuild_ns, result.mapped_access_ns, result.rebuilt_access_ns);
+}
+
+// Results of benchmarkSnapshot(), in nanoseconds per piece
+struct SnapshotBenchmark {
+    std::size_t pieces = 0;         // Pieces in the box
+    std::size_t bytes = 0;          // Length of its snapshot
+    double write_ns = 0;            // writeSnapshot()
+    double open_ns = 0;             // SnapshotView::open() with the checksum pass
+    double read_ns = 0;             // readSnapshot() into a box
+
+    // Snapshot bytes handled per second at the given ns per piece, in MB/s
+    double megabytesPerSecond(double ns_per_piece) const {
+        return ns_per_piece <= 0 || pieces == 0 ? 0.0 : bytes / (ns_per_piece * pieces) * 1e3;
+    }
+};
+
+// Writes, opens and reads back a snapshot of `box` `rounds` times; all zero if the box cannot be written
+template <template <typename> class Storage>
+static SnapshotBenchmark benchmarkSnapshot(const BasicChessBox<Storage>& box, int rounds) {
+    using Clock = std::chrono::steady_clock;
+    SnapshotBenchmark result;
+    rounds = rounds < 1 ? 1 : rounds;
+    std::vector<char> bytes;
+    if (!writeSnapshot(box, bytes)) {
+        return result;
+    }
+    for (int player = 0; player < box.playerCount(); player++) {
+        result.pieces += box.viewPieces(player).length();
+    }
+    result.bytes = bytes.size();
+    double pieces = static_cast<double>(result.pieces > 0 ? result.pieces : 1) * rounds;
+
+    Clock::time_point start = Clock::now();
+    for (int round = 0; round < rounds; round++) {
+        bytes.clear();
+        writeSnapshot(box, bytes);
+    }
+    result.write_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / pieces;
+
+    SnapshotView view;
+    start = Clock::now();
+    for (int round = 0; round < rounds; round++) {
+        view.open(bytes.data(), bytes.size());
+    }
+    result.open_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / pieces;
+
+    BasicChessBox<Storage> restored;
+    start = Clock::now();
+    for (int round = 0; round < rounds; round++) {
+        readSnapshot(view, restored);
+    }
+    result.read_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / pieces;
+    return result;
+}
+
+// Snapshot write/open/read of a three-player box of 20k pieces
+static void benchSnapshot() {
+    ChessBox box(std::vector<std::string>{"BLACK", "WHITE", "RED"}, std::vector<int>{20000, 20000, 20000});
+    for (int i = 0; i < 20000; i++) {
+        int player = i % 3;
+        bool rook = i % 5 == 0;
+        box.addPiece(ChessPiece(box.getColor(player), i % 8, (i / 8) % 8, player == 1, rook ? 2 : 1, rook ? "ROOK" : "PAWN"));
+    }
+    SnapshotBenchmark result = benchmarkSnapshot(box, 20);
+    std::printf("Snapshot, %zu pieces (%zu bytes), ns/piece: write %.1f (%.0f MB/s), open %.1f (%.0f MB/s), read %.1f\n",
+                result.pieces, result.bytes, result.write_ns, result.megabytesPerSecond(result.write_ns),
+                result.open_ns, result.megabytesPerSecond(result.open_ns), result.read_ns);
+}
+
+// FEN parse and write throughput, on a board with every pawn and rook field filled in and on START_FEN
+static void benchFen() {
+    typedef std::chrono::steady_clock Clock;
+    const char* const dense = "rrrrrrrr/pppppppp/8/8/8/8/PPPPPPPP/RRRRRRRR w a2b2c2d2e2f2g2h2a7b7c7d7e7f7g7h7 "
+                              "3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3";
+    const int positions = 2000000;
+    for (const char* fen : { dense, START_FEN }) {
+        Board board;
+        std::string_view text(fen);
+        std::int64_t sum = 0;
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < positions; i++) {
+            sum += parseFen(text, board) + board.evaluation();
+        }
+        double parse_s = std::chrono::duration<double>(Clock::now() - start).count();
+
+        char buffer[FEN_MAX_LENGTH];
+        start = Clock::now();
+        for (int i = 0; i < positions; i++) {
+            sum += static_cast<std::int64_t>(writeFen(board, buffer, sizeof(buffer)));
+        }
+        double write_s = std::chrono::duration<double>(Clock::now() - start).count();
+        std::printf("FEN, %zu chars: parse %.2fM positions/s, write %.2fM positions/s (%lld)\n", text.size(),
+                    positions / parse_s / 1e6, positions / write_s / 1e6, static_cast<long long>(sum));
+    }
+}
+
+// Name of the kernels this build uses
+#ifdef __AVX2__
+static const char* const KERNELS = "AVX2";
+#else
+static const char* const KERNELS = "scalar";
+#endif
+
+// PieceTable promotion plus pairwise castle masks over 1M random rows
+static void benchPieceTable() {
+    typedef std::chrono::steady_clock Clock;
+    const int rows = 1 << 20;
+    const int rounds = 20;
+    std::minstd_rand random(1);
+    PieceTable table;
+    PieceTable partners;
+    for (int i = 0; i < rows; i++) {
+        PieceType type = random() % 2 ? PieceType::Pawn : PieceType::Rook;
+        table.add(PackedPiece(type, static_cast<int>(random() % 2), static_cast<int>(random() % 8),
+                              static_cast<int>(random() % 8), random() % 2 == 0, false, static_cast<int>(random() % 3)));
+        partners.add(PackedPiece(PieceType::Rook, static_cast<int>(random() % 2), static_cast<int>(random() % 8),
+                                 static_cast<int>(random() % 8), true, false, 1));
+    }
+    PieceTable::Mask promotions;
+    PieceTable::Mask castles;
+    std::size_t bits = 0;
+    Clock::time_point start = Clock::now();
+    for (int round = 0; round < rounds; round++) {
+        table.promotionMask(promotions);
+        table.castleMask(partners, castles);
+        bits += PieceTable::countBits(promotions) + PieceTable::countBits(castles);
+    }
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / rounds;
+    std::printf("PieceTable (%s), %d rows: promotion + pairwise castle masks %.2f ms (%zu bits set)\n",
+                KERNELS, rows, ms, bits / rounds);
+}
+
+// rooksSharingRow() on 4M positions, against the same query built from pairwise intersect and
+// unite calls. Rooks crowd the back row, so its posting lists are bitmaps and the others arrays.
+static void benchPositionQuery() {
+    typedef std::chrono::steady_clock Clock;
+    const int positions = 1 << 22;
+    const int rounds = 5;
+    std::minstd_rand random(1);
+    PositionIndex index;
+    Board board;
+    for (int i = 0; i < positions; i++) {
+        board.clear();
+        for (int col = 0; col < Board::BOARD_LENGTH; col++) {
+            if (random() % 5 < 2) {
+                board.place(PackedPiece(PieceType::Rook, Board::WHITE_PLAYER, 0, col, true));
+            }
+        }
+        for (int rook = 0; rook < 2; rook++) {
+            board.place(PackedPiece(PieceType::Rook, Board::WHITE_PLAYER, static_cast<int>(random() % 8),
+                                    static_cast<int>(random() % 8), true));
+        }
+        index.addPosition(board);
+    }
+
+    std::uint64_t hits = 0;
+    Clock::time_point start = Clock::now();
+    for (int round = 0; round < rounds; round++) {
+        hits += index.rooksSharingRow(Board::WHITE_PLAYER).cardinality();
+    }
+    double fused_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / rounds;
+
+    std::uint64_t pairwise_hits = 0;
+    start = Clock::now();
+    for (int round = 0; round < rounds; round++) {
+        RoaringBitmap result;
+        for (int row = 0; row < Board::BOARD_LENGTH; row++) {
+            RoaringBitmap seen;
+            RoaringBitmap twice;
+            for (int col = 0; col < Board::BOARD_LENGTH; col++) {
+                const RoaringBitmap& list = index.postings(Board::WHITE_PLAYER, PieceType::Rook, row * Board::BOARD_LENGTH + col);
+                twice = RoaringBitmap::unite(twice, RoaringBitmap::intersect(seen, list));
+                seen = RoaringBitmap::unite(seen, list);
+            }
+            result = RoaringBitmap::unite(result, twice);
+        }
+        pairwise_hits += result.cardinality();
+    }
+    double pairwise_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / rounds;
+
+    const RoaringBitmap& a1 = index.postings(Board::WHITE_PLAYER, PieceType::Rook, 0);
+    const RoaringBitmap& b1 = index.postings(Board::WHITE_PLAYER, PieceType::Rook, 1);
+    std::uint64_t both = 0;
+    start = Clock::now();
+    for (int round = 0; round < 100; round++) {
+        both += RoaringBitmap::intersectCount(a1, b1);
+    }
+    double count_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / 100;
+    std::printf("PositionIndex (%s), %d positions: rooksSharingRow %.2f ms (pairwise %.2f ms%s), "
+                "intersectCount of two bitmap lists %.3f ms (%llu)\n",
+                KERNELS, positions, fused_ms, pairwise_ms, hits == pairwise_hits ? "" : ", results differ",
+                count_ms, static_cast<unsigned long long>(both / 100));
+}
+
+// NeuralNetwork cost per search node: makeMove + applyMove + evaluate + unmakeMove, cycling
+// through every pseudo-legal move of the start position. The weights stay zero, which
+// costs the same as trained ones: the kernels do the same work whatever the values.
+static void benchNeuralNetwork() {
+    typedef std::chrono::steady_clock Clock;
+    NeuralNetwork network;
+    Board board;
+    parseFen(START_FEN, board);
+    std::vector<Move> moves;
+    for (int from = 0; from < Board::SQUARES; from++) {
+        for (int to = 0; to < Board::SQUARES; to++) {
+            if (board.isPseudoLegal(Move(from, to))) {
+                moves.push_back(Move(from, to));
+            }
+        }
+    }
+    NeuralNetwork::Accumulator acc;
+    network.refresh(board, acc);
+
+    const int nodes = 2000000;
+    std::int64_t sum = 0;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < nodes; i++) {
+        const Move& move = moves[i % moves.size()];
+        Undo undo = board.makeMove(move);
+        NeuralNetwork::Accumulator child;
+        network.applyMove(acc, move, undo, board, child);
+        sum += network.evaluate(child);
+        board.unmakeMove(move, undo);
+    }
+    double node_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / nodes;
+
+    start = Clock::now();
+    for (int i = 0; i < nodes / 10; i++) {
+        network.refresh(board, acc);
+        sum += acc.values[i % NeuralNetwork::HIDDEN];
+    }
+    double refresh_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / (nodes / 10);
+    std::printf("NeuralNetwork (%s), %zu moves: make + applyMove + evaluate + unmake %.1f ns/node, refresh %.1f ns (%lld)\n",
+                KERNELS, moves.size(), node_ns, refresh_ns, static_cast<long long>(sum));
+}
+
+// Task spawn cost and parallel-for speedup on every core
+static void benchScheduler() {
+    Scheduler scheduler;
+    SchedulerBenchmark result = benchmarkScheduler(scheduler);
+    std::printf("Scheduler, %d workers: spawn %.0f ns/task (std::thread %.0f ns), parallelFor %.2f ns/item (serial %.2f, %.1fx)\n",
+                result.threads, result.spawn_ns, result.thread_ns, result.parallel_for_ns, result.serial_for_ns,
+                result.speedup());
+}
+
+// Lock-free ConcurrentLinkedBox against a mutex-wrapped LinkedBox, 1 to 8 threads
+static void benchConcurrentBox() {
+    ChessPiece pawn("WHITE", 1, 0, true, 1, "PAWN");
+    for (int threads : { 1, 2, 4, 8 }) {
+        ContentionBenchmark result = benchmarkConcurrentBox(pawn, threads, 20000);
+        std::printf("ConcurrentLinkedBox, %d threads: %.1f ns/op (locked LinkedBox %.1f ns/op)\n",
+                    result.threads, result.concurrent_ns, result.locked_ns);
+    }
+}
+
+// Game server throughput: 2000 games of 60 moves
+static void benchGameServer() {
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    std::cout << "GameServer load test: " << runLoadTest(threads > 0 ? threads : 1, 2000, 60) << std::endl;
+}
+
+int main() {
+    benchBoxPolicies();
+    benchBatchAdd();
+    benchMappedBox();
+    benchSnapshot();
+    benchFen();
+    benchPieceTable();
+    benchPositionQuery();
+    benchNeuralNetwork();
+    benchScheduler();
+    benchConcurrentBox();
+    benchGameServer();
+    return 0;
+}
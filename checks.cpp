@@ -0,0 +1,640 @@
+// File: checks.cpp
+// Date: 10/18/26
+// Self-checks for the library: runs every check the library provides, plus contract checks
+// that instantiate each container. Prints PASS/FAIL per check and exits non-zero on a failure.
+// Built and run by `make check`.
+
+#include "ArrayBox.hpp"
+#include "Board.hpp"
+#include "Box.hpp"
+#include "ChessBox.hpp"
+#include "ChessBoxSnapshot.hpp"
+#include "ChessPiece.hpp"
+#include "ConcurrentLinkedBox.hpp"
+#include "Evaluation.hpp"
+#include "Fen.hpp"
+#include "GameCodec.hpp"
+#include "GameReader.hpp"
+#include "GameServer.hpp"
+#include "MappedArrayBox.hpp"
+#include "NeuralEvaluation.hpp"
+#include "PackedPiece.hpp"
+#include "PersistentLinkedBox.hpp"
+#include "PieceTable.hpp"
+#include "PositionIndex.hpp"
+#include "RoaringBitmap.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int failures = 0;
+
+// Prints the outcome of one check and counts failures
+static void report(const char* name, bool passed) {
+    std::cout << (passed ? "PASS " : "FAIL ") << name << std::endl;
+    if (!passed) {
+        failures++;
+    }
+}
+
+// A random PAWN, ROOK or QUEEN (sizes 1, 2 and 3) for the container checks
+static ChessPiece randomPiece(std::minstd_rand& random) {
+    static const char* const TYPES[3] = { "PAWN", "ROOK", "QUEEN" };
+    int kind = static_cast<int>(random() % 3);
+    return ChessPiece("WHITE", static_cast<int>(random() % 8), static_cast<int>(random() % 8), true, kind + 1, TYPES[kind]);
+}
+
+// Runs the same random addItem/remove/count sequence on a Box and an ArrayBox, which share a
+// contract: every call must return the same thing, and the sizes must stay equal
+template <template <typename> class Storage>
+static bool checkBoxContract(unsigned seed) {
+    std::minstd_rand random(seed);
+    Box<ChessPiece, Storage> box(48);
+    ArrayBox<ChessPiece> reference(48);
+    for (int i = 0; i < 2000; i++) {
+        ChessPiece piece = randomPiece(random);
+        bool same = true;
+        switch (random() % 3) {
+            case 0:
+                same = box.addItem(piece) == reference.addItem(piece);
+                break;
+            case 1:
+                same = box.remove(piece.getType()) == reference.remove(piece.getType());
+                break;
+            default:
+                same = box.count(piece.getType()) == reference.count(piece.getType()) &&
+                       box.contains(piece.getType()) == reference.contains(piece.getType());
+                break;
+        }
+        if (!same || box.size() != reference.size()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Saves a MappedArrayBox, reopens it read-only and compares it with an ArrayBox built the same way
+static bool checkMappedBox(const std::string& path) {
+    std::remove(path.c_str());
+    std::minstd_rand random(3);
+    ArrayBox<PackedPiece> reference(256);
+    {
+        MappedArrayBox<PackedPiece> mapped;
+        if (!mapped.openReadWrite(path, 256)) {
+            return false;
+        }
+        mapped.setSyncOnWrite(false);
+        for (int i = 0; i < 500; i++) {
+            // QUEENs have no PackedPiece type and are skipped
+            PackedPiece piece;
+            if (!PackedPiece::fromPiece(randomPiece(random), 1, piece)) {
+                continue;
+            }
+            bool removing = random() % 4 == 0;
+            if (removing ? mapped.remove(piece.getType()) != reference.remove(piece.getType())
+                         : mapped.addItem(piece) != reference.addItem(piece)) {
+                return false;
+            }
+        }
+    }
+    MappedArrayBox<PackedPiece> reopened;
+    if (!reopened.openReadOnly(path) || reopened.size() != reference.size() || reopened.addItem(PackedPiece())) {
+        return false;
+    }
+    for (int index = 0; index < reference.size(); index++) {
+        if (!(reopened.at(index) == reference.at(index))) {
+            return false;
+        }
+    }
+    bool counts = reopened.count("PAWN") == reference.count("PAWN") && reopened.count("ROOK") == reference.count("ROOK");
+    reopened.close();
+    std::remove(path.c_str());
+    return counts;
+}
+
+// A writer that crashed after its header's size reached the file but before the items did, as
+// the old flush order allowed: the zeroed spaces past the items must make the open fail, and
+// walking zeroed spaces (type NONE, size 0) must still finish
+static bool checkMappedBoxCrash(const std::string& path) {
+    std::remove(path.c_str());
+    {
+        MappedArrayBox<PackedPiece> mapped;
+        if (!mapped.openReadWrite(path, 16) || !mapped.addItem(PackedPiece(PieceType::Rook, 1, 0, 0, true)) ||
+            !mapped.addItem(PackedPiece(PieceType::Pawn, 1, 1, 0, true)) || !mapped.remove("PAWN")) {
+            return false;
+        }
+    }
+    MappedArrayBox<PackedPiece> reopened;
+    bool clean = reopened.openReadOnly(path);
+    reopened.close();
+
+    std::int32_t torn_size = 5;
+    std::uint64_t dirty = 1;
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(offsetof(MappedBoxHeader, size));
+        file.write(reinterpret_cast<const char*>(&torn_size), sizeof(torn_size));
+        file.seekp(offsetof(MappedBoxHeader, dirty));
+        file.write(reinterpret_cast<const char*>(&dirty), sizeof(dirty));
+    }
+    bool rejected = clean && !reopened.openReadOnly(path) && !reopened.openReadWrite(path);
+    std::remove(path.c_str());
+
+    PackedPiece zeroed[4];
+    std::memset(static_cast<void*>(zeroed), 0, sizeof(zeroed));
+    return rejected && slotCount(zeroed, "NONE", 4) == 4;
+}
+
+// Adds from several threads while one thread removes and another reads; the final size must
+// match the adds that succeeded minus the removes that did
+static bool checkConcurrentBox() {
+    const int threads = 4;
+    const int adds = 5000;
+    ConcurrentLinkedBox<ChessPiece> box(threads * adds);
+    std::vector<std::thread> workers;
+    std::vector<int> added(threads, 0);
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&box, &added, t] {
+            for (int i = 0; i < adds; i++) {
+                added[t] += box.addItem(ChessPiece("WHITE", t, i % 8, true, 1, i % 2 ? "PAWN" : "ROOK"));
+            }
+        });
+    }
+    int removed = 0;
+    workers.emplace_back([&box, &removed] {
+        for (int i = 0; i < adds; i++) {
+            removed += box.remove("ROOK");
+        }
+    });
+    bool counts_valid = true;
+    workers.emplace_back([&box, &counts_valid] {
+        for (int i = 0; i < adds; i++) {
+            counts_valid = counts_valid && box.count("PAWN") <= threads * adds / 2;
+        }
+    });
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    int total = 0;
+    for (int count : added) {
+        total += count;
+    }
+    return counts_valid && total == threads * adds && box.size() == total - removed &&
+           box.count("PAWN") == threads * adds / 2 && box.count("ROOK") == threads * adds / 2 - removed;
+}
+
+// Snapshot round trip: builds boxes with several players, different capacities, and pieces
+// added and removed in a mixed order, then writes, opens and reads each one back and compares
+// every player's color, capacity and pieces in forEach order. Also checks that a box holding
+// a piece that cannot be packed is not written, and that a snapshot whose pieces overflow a
+// capacity is not read.
+template <template <typename> class Storage>
+static bool checkSnapshotRoundTrip() {
+    typedef BasicChessBox<Storage> Boxes;
+    auto samePieces = [](const Boxes& a, const Boxes& b) {
+        if (a.playerCount() != b.playerCount()) {
+            return false;
+        }
+        for (int player = 0; player < a.playerCount(); player++) {
+            std::vector<ChessPiece> left;
+            std::vector<ChessPiece> right;
+            a.viewPieces(player).forEach([&left](const ChessPiece& piece) { left.push_back(piece); });
+            b.viewPieces(player).forEach([&right](const ChessPiece& piece) { right.push_back(piece); });
+            if (a.getColor(player) != b.getColor(player) ||
+                a.viewPieces(player).capacity() != b.viewPieces(player).capacity() || left.size() != right.size()) {
+                return false;
+            }
+            for (std::size_t i = 0; i < left.size(); i++) {
+                if (left[i].getType() != right[i].getType() || left[i].getColor() != right[i].getColor() ||
+                    left[i].getRow() != right[i].getRow() || left[i].getColumn() != right[i].getColumn() ||
+                    left[i].isMovingUp() != right[i].isMovingUp() || left[i].size() != right[i].size()) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+
+    for (int pieces = 0; pieces <= 40; pieces += 8) {
+        Boxes original(std::vector<std::string>{"BLACK", "WHITE", "RED"}, std::vector<int>{100, 60, 90});
+        for (int i = 0; i < pieces; i++) {
+            int player = i % 3;
+            bool rook = i % 5 == 0;
+            original.addPiece(ChessPiece(original.getColor(player), i % 8, (i * 3) % 8, player == 1,
+                                         rook ? 2 : 1, rook ? "ROOK" : "PAWN"));
+            if (i % 7 == 6) {
+                original.removePiece("PAWN", original.getColor(player));
+            }
+        }
+
+        std::vector<char> bytes;
+        SnapshotView view;
+        Boxes restored;
+        if (!writeSnapshot(original, bytes) || !view.open(bytes.data(), bytes.size()) ||
+            !readSnapshot(view, restored) || !samePieces(original, restored)) {
+            return false;
+        }
+    }
+
+    // A QUEEN has no PackedPiece type: writing fails and leaves the buffer as it was
+    Boxes queen;
+    queen.addPiece(ChessPiece("WHITE", 0, 3, true, 3, "QUEEN"));
+    std::vector<char> bytes(1, 'x');
+    if (writeSnapshot(queen, bytes) || bytes.size() != 1) {
+        return false;
+    }
+
+    // Shrinking player 1's recorded capacity below its pieces makes the snapshot unreadable
+    Boxes full("BLACK", "WHITE", 4);
+    full.addPiece(ChessPiece("WHITE", 0, 0, true, 2, "ROOK"));
+    full.addPiece(ChessPiece("WHITE", 0, 1, true, 2, "ROOK"));
+    bytes.clear();
+    writeSnapshot(full, bytes);
+    SnapshotPlayer record;
+    std::memcpy(&record, bytes.data() + sizeof(SnapshotHeader) + sizeof(SnapshotPlayer), sizeof(record));
+    record.capacity = 3;
+    std::memcpy(bytes.data() + sizeof(SnapshotHeader) + sizeof(SnapshotPlayer), &record, sizeof(record));
+    SnapshotView view;
+    Boxes restored;
+    return view.open(bytes.data(), bytes.size(), false) && !readSnapshot(view, restored) &&
+           restored.viewPieces(1).size() == 0;
+}
+
+// An item that counts its live copies, so the checks can see nodes being freed
+struct TrackedItem {
+    static std::atomic<int> live;
+
+    std::string type;
+    int item_size;
+
+    TrackedItem(const std::string& item_type = "PAWN", int size = 1) : type(item_type), item_size(size) { live++; }
+    TrackedItem(const TrackedItem& other) : type(other.type), item_size(other.item_size) { live++; }
+    TrackedItem& operator=(const TrackedItem& other) = default;
+    ~TrackedItem() { live--; }
+
+    const std::string& getType() const { return type; }
+    int size() const { return item_size; }
+};
+
+std::atomic<int> TrackedItem::live(0);
+
+// The types of a version, newest first
+static std::string typesOf(const PersistentLinkedBox<TrackedItem>& box) {
+    std::string types;
+    box.forEach([&types](const TrackedItem& item) { types += item.getType()[0]; });
+    return types;
+}
+
+// Structural sharing and reference counts: versions built in place (result aliasing *this)
+// leave snapshots intact, only the nodes in front of a removed item are copied, and every
+// node is freed once the last version holding it is gone, including from other threads
+static bool checkPersistentBox() {
+    {
+        PersistentLinkedBox<TrackedItem> box(8);
+        for (const char* type : { "PAWN", "ROOK", "PAWN", "ROOK", "PAWN" }) {
+            if (!box.addItem(TrackedItem(type, type[0] == 'R' ? 2 : 1), box)) {
+                return false;
+            }
+        }
+        // Over capacity: fails and leaves the result alone
+        bool added = box.addItem(TrackedItem("ROOK", 2), box);
+        if (added || box.size() != 7 || TrackedItem::live != 5) {
+            return false;
+        }
+
+        PersistentLinkedBox<TrackedItem> snapshot = box;
+        if (!snapshot.sharesHeadWith(box) || TrackedItem::live != 5) {
+            return false;
+        }
+
+        // Removing the newest ROOK copies the PAWN in front of it and shares the other three nodes
+        if (!box.remove("ROOK", box) || typesOf(box) != "PPRP" || box.size() != 5 ||
+            typesOf(snapshot) != "PRPRP" || snapshot.size() != 7 || box.sharesHeadWith(snapshot) ||
+            TrackedItem::live != 6) {
+            return false;
+        }
+        if (box.remove("QUEEN", box) || typesOf(box) != "PPRP") {
+            return false;
+        }
+
+        // Dropping the snapshot frees only the nodes no other version reaches
+        PersistentLinkedBox<TrackedItem> grown;
+        added = box.addItem(TrackedItem("ROOK", 2), grown);
+        if (!added || typesOf(grown) != "RPPRP" || typesOf(box) != "PPRP") {
+            return false;
+        }
+        snapshot = PersistentLinkedBox<TrackedItem>();
+        if (TrackedItem::live != 5) {
+            return false;
+        }
+
+        // Versions released from several threads at once
+        std::vector<std::thread> workers;
+        for (int t = 0; t < 4; t++) {
+            workers.emplace_back([version = grown]() mutable {
+                for (int i = 0; i < 1000; i++) {
+                    PersistentLinkedBox<TrackedItem> next;
+                    version.remove("PAWN", next);
+                    next.addItem(TrackedItem("PAWN", 1), version);
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        if (typesOf(grown) != "RPPRP" || TrackedItem::live != 5) {
+            return false;
+        }
+    }
+    return TrackedItem::live == 0;
+}
+
+// A random pawn, rook or NONE, crowded onto the edge rows and the first columns so that
+// promotions and castles come up often
+static PackedPiece randomPackedPiece(std::minstd_rand& random) {
+    static const PieceType TYPES[3] = { PieceType::Pawn, PieceType::Rook, PieceType::None };
+    static const int ROWS[6] = { -1, 0, 0, 7, 7, 3 };
+    int row = ROWS[random() % 6];
+    return PackedPiece(TYPES[random() % 3], static_cast<int>(random() % 2), row, static_cast<int>(random() % 3),
+                       random() % 2 == 0, random() % 2 == 0, static_cast<int>(random() % 3));
+}
+
+// Compares the PieceTable kernels (AVX2 when built with it) with PackedPiece::canPromote()
+// and canCastle() on random rows, with a row count that leaves a partial final block
+static bool checkPieceTable(unsigned seed) {
+    std::minstd_rand random(seed);
+    const std::size_t rows = 10007;
+    PieceTable table;
+    PieceTable partners;
+    for (std::size_t i = 0; i < rows; i++) {
+        table.add(randomPackedPiece(random));
+        partners.add(randomPackedPiece(random));
+    }
+    PackedPiece partner(PieceType::Rook, 1, 0, 1, true);
+    PieceTable::Mask promotions;
+    PieceTable::Mask castles;
+    PieceTable::Mask castles_one;
+    table.promotionMask(promotions);
+    table.castleMask(partner, castles_one);
+    if (!table.castleMask(partners, castles) || promotions.size() != (rows + 63) / 64) {
+        return false;
+    }
+    std::size_t promoting = 0;
+    for (std::size_t i = 0; i < rows; i++) {
+        bool promotes = (promotions[i / 64] >> (i % 64)) & 1;
+        bool castles_row = (castles[i / 64] >> (i % 64)) & 1;
+        bool castles_partner = (castles_one[i / 64] >> (i % 64)) & 1;
+        if (promotes != table.piece(i).canPromote() || castles_row != table.piece(i).canCastle(partners.piece(i)) ||
+            castles_partner != table.piece(i).canCastle(partner)) {
+            return false;
+        }
+        promoting += promotes;
+    }
+    // Bits past the last row stay clear, so countBits() counts rows only
+    PieceTable shorter;
+    return PieceTable::countBits(promotions) == promoting && !shorter.castleMask(partners, castles);
+}
+
+// Round-trips random boards through writeFen() and parseFen(), which scores the parsed board
+// once at the end: the score and pawn key must match a board built with place(), and
+// evaluateBatch() (the AVX2 gather when built with it) must match evaluate()
+static bool checkFenEvaluation(unsigned seed) {
+    std::minstd_rand random(seed);
+    const int boards = 500;
+    std::vector<Board> parsed(boards);
+    std::vector<std::int32_t> scores(boards);
+    for (int i = 0; i < boards; i++) {
+        Board board;
+        int pieces = static_cast<int>(random() % 40);
+        for (int j = 0; j < pieces; j++) {
+            bool pawn = random() % 2 == 0;
+            int color = static_cast<int>(random() % 2);
+            PackedPiece piece(pawn ? PieceType::Pawn : PieceType::Rook, color, static_cast<int>(random() % 8),
+                              static_cast<int>(random() % 8), color == Board::WHITE_PLAYER, random() % 2 == 0,
+                              static_cast<int>(random() % 4));
+            board.place(piece);
+        }
+        board.setSideToMove(static_cast<int>(random() % 2));
+        if (!parseFen(toFen(board), parsed[i]) || parsed[i] != board || parsed[i].evaluation() != board.evaluation() ||
+            parsed[i].pawnKey() != board.pawnKey() || parsed[i].evaluation() != evaluate(parsed[i])) {
+            return false;
+        }
+    }
+    evaluateBatch(parsed.data(), parsed.size(), scores.data());
+    for (int i = 0; i < boards; i++) {
+        if (scores[i] != evaluate(parsed[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Writes a weight file in NeuralNetwork's layout with small random weights
+static bool writeRandomWeights(const std::string& path, unsigned seed) {
+    std::minstd_rand random(seed);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    std::uint32_t header[4] = { NEURAL_NETWORK_VERSION, NeuralNetwork::FEATURES, NeuralNetwork::HIDDEN, 6 };
+    file.write("CBNN", 4);
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    for (int i = 0; i < NeuralNetwork::HIDDEN * (1 + NeuralNetwork::FEATURES); i++) {
+        std::int16_t weight = static_cast<std::int16_t>(static_cast<int>(random() % 41) - 20 + (i < NeuralNetwork::HIDDEN ? 30 : 0));
+        file.write(reinterpret_cast<const char*>(&weight), sizeof(weight));
+    }
+    for (int i = 0; i < NeuralNetwork::HIDDEN; i++) {
+        std::int8_t weight = static_cast<std::int8_t>(static_cast<int>(random() % 255) - 127);
+        file.write(reinterpret_cast<const char*>(&weight), sizeof(weight));
+    }
+    std::int32_t bias = 123;
+    file.write(reinterpret_cast<const char*>(&bias), sizeof(bias));
+    return static_cast<bool>(file);
+}
+
+// The accumulator refresh() builds for the pieces of a ChessBox; pieces may share squares,
+// which a Board cannot hold, so their rows are added one by one
+static void refreshFromBox(const NeuralNetwork& network, const ChessBox& box, NeuralNetwork::Accumulator& acc) {
+    network.refresh(Board(), acc);
+    for (int player = 0; player < box.playerCount(); player++) {
+        box.viewPieces(player).forEach([&](const ChessPiece& piece) {
+            PackedPiece packed;
+            if (PackedPiece::fromPiece(piece, player, packed) && packed.onBoard()) {
+                network.addPiece(acc, packed, packed.square());
+            }
+        });
+    }
+}
+
+// The incremental accumulator must equal a refresh() everywhere: after applyMove() on random
+// moves (captures and promotions included), after unmaking them, and after applying a
+// ChessBox's change records, including pieces the network has no features for
+static bool checkNeuralNetwork(const std::string& path) {
+    NeuralNetwork network;
+    NeuralNetwork reloaded;
+    bool loaded = writeRandomWeights(path, 11) && network.load(path) && network.save(path) && reloaded.load(path);
+    std::remove(path.c_str());
+    if (!loaded) {
+        return false;
+    }
+
+    std::minstd_rand random(5);
+    for (int game = 0; game < 200; game++) {
+        Board board;
+        for (int i = 0; i < 24; i++) {
+            int square = static_cast<int>(random() % Board::SQUARES);
+            int player = static_cast<int>(random() % 2);
+            PieceType type = random() % 3 == 0 ? PieceType::Rook : PieceType::Pawn;
+            board.place(PackedPiece(type, player, square / 8, square % 8, player == Board::WHITE_PLAYER, random() % 2 == 0, 3));
+        }
+        NeuralNetwork::Accumulator acc;
+        network.refresh(board, acc);
+        for (int ply = 0; ply < 40; ply++) {
+            int from = static_cast<int>(random() % Board::SQUARES);
+            int to = static_cast<int>(random() % Board::SQUARES);
+            if (board.isEmpty(from) || from == to) {
+                continue;
+            }
+            Move move(from, to, random() % 4 == 0 ? Move::PROMOTION : 0);
+            Undo undo = board.makeMove(move);
+            NeuralNetwork::Accumulator next;
+            NeuralNetwork::Accumulator expected;
+            network.applyMove(acc, move, undo, board, next);
+            network.refresh(board, expected);
+            if (std::memcmp(&next, &expected, sizeof(next)) != 0 || network.evaluate(next) != reloaded.evaluate(expected)) {
+                return false;
+            }
+            if (random() % 3 == 0) {
+                board.unmakeMove(move, undo);
+                network.refresh(board, expected);
+                if (std::memcmp(&acc, &expected, sizeof(acc)) != 0) {
+                    return false;
+                }
+            } else {
+                acc = next;
+            }
+        }
+    }
+
+    // The same through a ChessBox's change feed
+    static const char* const TYPES[3] = { "PAWN", "ROOK", "QUEEN" };
+    ChangeFeed feed(1024);
+    ChessBox box;
+    box.setChangeFeed(&feed);
+    NeuralNetwork::Accumulator acc;
+    NeuralNetwork::Accumulator expected;
+    network.refresh(Board(), acc);
+    std::vector<ChangeRecord> records;
+    for (int step = 0; step < 2000; step++) {
+        int player = static_cast<int>(random() % 2);
+        int kind = static_cast<int>(random() % 3);
+        switch (random() % 3) {
+            case 0:
+                box.addPiece(ChessPiece(box.getColor(player), static_cast<int>(random() % 8), static_cast<int>(random() % 8),
+                                        player == Board::WHITE_PLAYER, kind + 1, TYPES[kind]));
+                break;
+            case 1:
+                box.removePiece(TYPES[kind], box.getColor(player));
+                break;
+            default:
+                box.movePiece(static_cast<int>(random() % 8), static_cast<int>(random() % 8),
+                              static_cast<int>(random() % 8), static_cast<int>(random() % 8));
+                break;
+        }
+        records.clear();
+        feed.drain(records);
+        for (const ChangeRecord& record : records) {
+            network.apply(record, acc);
+        }
+        refreshFromBox(network, box, expected);
+        if (std::memcmp(&acc, &expected, sizeof(acc)) != 0) {
+            return false;
+        }
+    }
+    return feed.dropped() == 0;
+}
+
+// Encodes a few thousand short games, indexes them and checks the index against the boards,
+// directly and after a save/load round trip
+static bool checkIndexedGames(const std::string& path) {
+    std::string rooks = "[Result \"1-0\"]\n\n1. e4 d5 2. exd5 h5 3. a4 h4 4. Ra3 Rh5 5. Rb3 Rxd5 6. Rxb7 Rd2 "
+                        "7. Rxc7 Rxf2 8. c4 Rxg2 9. Rc8+ Rgxh2 1-0\n\n";
+    std::string promotion = "[FEN \"1r6/P7/8/8/8/8/8/R6R w - 3,3,3\"]\n\n1. Rad1 Rb2 2. a8=R Rb8 3. Rhe1 *\n\n";
+    std::string text;
+    for (int i = 0; i < 1000; i++) {
+        text += rooks;
+        text += promotion;
+    }
+    GameEncoder encoder;
+    GameParser parser(text);
+    GameRecord game;
+    while (parser.next(game)) {
+        if (!encoder.addGame(game)) {
+            return false;
+        }
+    }
+    std::string_view data(encoder.data().data(), encoder.data().size());
+    GameDecoder decoder;
+    PositionIndex index;
+    if (!decoder.open(data) || index.addGames(decoder) != 2000 || !decoder.open(data) ||
+        !checkPositionIndex(index, decoder)) {
+        return false;
+    }
+    PositionIndex loaded;
+    bool round_trip = index.save(path) && loaded.load(path) && decoder.open(data) && checkPositionIndex(loaded, decoder);
+    std::remove(path.c_str());
+    return round_trip;
+}
+
+// Drives the line client through a short session; replies arrive in any order
+static bool checkLineClient() {
+    std::istringstream in("NEW\nMOVE 0 e4\nMOVE 0 e4\nMOVE 0 e5\nEND 0\nMOVE 0 e5\nQUIT\n");
+    std::ostringstream out;
+    runLineClient(in, out, 2);
+    std::string replies = out.str();
+    for (const char* expected : { "STARTED 0", "MOVED 0 1 e2-e4", "ILLEGAL 0", "MOVED 0 2 e7-e5", "ENDED 0", "NOT_PLAYING 0" }) {
+        if (replies.find(expected) == std::string::npos) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    report("Box<ArrayStorage> matches ArrayBox", checkBoxContract<ArrayStorage>(1));
+    report("Box<LinkedStorage> matches ArrayBox", checkBoxContract<LinkedStorage>(2));
+    report("Box<UnrolledStorage> matches ArrayBox", checkBoxContract<UnrolledStorage>(3));
+    report("Box<InlineStorage> matches ArrayBox", checkBoxContract<InlineStorage>(4));
+    report("MappedArrayBox matches ArrayBox", checkMappedBox("checks_box.bin"));
+    report("MappedArrayBox rejects a torn file", checkMappedBoxCrash("checks_box.bin"));
+    report("ConcurrentLinkedBox", checkConcurrentBox());
+    report("PersistentLinkedBox sharing and reference counts", checkPersistentBox());
+#ifdef __AVX2__
+    report("PieceTable masks match PackedPiece (AVX2)", checkPieceTable(1));
+#else
+    report("PieceTable masks match PackedPiece (scalar)", checkPieceTable(1));
+#endif
+#ifdef __AVX2__
+    report("FEN round trip and evaluateBatch match evaluate() (AVX2)", checkFenEvaluation(1));
+#else
+    report("FEN round trip and evaluateBatch match evaluate() (scalar)", checkFenEvaluation(1));
+#endif
+    report("NeuralNetwork incremental accumulator matches refresh()", checkNeuralNetwork("checks_weights.nn"));
+    report("ChessBox stats under concurrent detach (linked)", checkConcurrentStats<LinkedStorage>(200));
+    report("ChessBox stats under concurrent detach (array)", checkConcurrentStats<ArrayStorage>(200));
+    report("Snapshot round trip (linked)", checkSnapshotRoundTrip<LinkedStorage>());
+    report("Snapshot round trip (array)", checkSnapshotRoundTrip<ArrayStorage>());
+    report("Snapshot round trip (unrolled)", checkSnapshotRoundTrip<UnrolledStorage>());
+    report("Snapshot round trip (inline)", checkSnapshotRoundTrip<InlineStorage>());
+    report("RoaringBitmap", checkRoaringBitmap(1, 20));
+    report("PositionIndex", checkIndexedGames("checks_index.bin"));
+    report("Line client", checkLineClient());
+
+    std::cout << (failures == 0 ? "All checks passed" : "Some checks failed") << std::endl;
+    return failures == 0 ? 0 : 1;
+}